@@ -0,0 +1,122 @@
+#ifndef BAKED_MODELS_H
+#define BAKED_MODELS_H
+
+#include <array>
+#include <cstddef>
+
+// ں決ģ͵Ĺ
+// ʱģͣԻֱ constexpr ɣ
+// ڱȥغ޳Ƕ std::arrayֻݶΣʱ㿪
+//
+// ע⣺MSVC ÿγֵĬ 1048576 Իȥ޳
+//  CppProperties.json  /constexpr:steps10000000ԼʱҲҪء
+// ɺȥ޳ֳ constexpr ԵƲ
+
+// ʹõĶرֱӵ±ʧ
+template <class V, size_t N>
+struct BakeTable {
+    std::array<V, N> items{};
+    size_t count = 0;
+
+    constexpr void add(float x, float y, float z, float r, float g, float b) {
+        items[count++] = V{ x, y, z, r, g, b };
+    }
+};
+
+// λ 0.0001ڱȽǷغ
+struct BakeKey {
+    long x, y, z;
+};
+
+constexpr long bakeQuantize(float v) {
+    float s = v * 10000.0f;
+    return (long)(s >= 0.0f ? s + 0.5f : s - 0.5f);
+}
+
+constexpr size_t bakeHashSize(size_t n) {
+    size_t s = 1;
+    while (s < n * 2) s <<= 1;
+    return s;
+}
+
+constexpr size_t bakeHash(const BakeKey& k) {
+    unsigned long long h = (unsigned long long)k.x * 73856093ULL ^
+        (unsigned long long)k.y * 19349663ULL ^ (unsigned long long)k.z * 83492791ULL;
+    return (size_t)(h ^ (h >> 17));
+}
+
+// Ѱַϣ¼ÿλõһγֵ±
+template <size_t N>
+struct BakeIndex {
+    static constexpr size_t SIZE = bakeHashSize(N);
+    std::array<BakeKey, SIZE> keys{};
+    std::array<int, SIZE> slots{};
+
+    constexpr BakeIndex() {
+        for (size_t i = 0; i < SIZE; ++i) slots[i] = -1;
+    }
+
+    // Ѵڷ false
+    constexpr bool insert(const BakeKey& k, int index) {
+        size_t i = bakeHash(k) & (SIZE - 1);
+        while (slots[i] >= 0) {
+            if (keys[i].x == k.x && keys[i].y == k.y && keys[i].z == k.z) return false;
+            i = (i + 1) & (SIZE - 1);
+        }
+        keys[i] = k;
+        slots[i] = index;
+        return true;
+    }
+
+    constexpr bool contains(const BakeKey& k) const {
+        size_t i = bakeHash(k) & (SIZE - 1);
+        while (slots[i] >= 0) {
+            if (keys[i].x == k.x && keys[i].y == k.y && keys[i].z == k.z) return true;
+            i = (i + 1) & (SIZE - 1);
+        }
+        return false;
+    }
+};
+
+// ȥظλõأȳֵǸȲȻӮĽһ£
+// ޳涼ͬߴסڲأԭ˳
+template <class V, size_t N>
+constexpr BakeTable<V, N> bakeDedupAndCull(const BakeTable<V, N>& in, float voxelSize) {
+    BakeIndex<N> index;
+    std::array<bool, N> keep{};
+
+    for (size_t i = 0; i < in.count; ++i) {
+        const V& v = in.items[i];
+        BakeKey k = { bakeQuantize(v.x), bakeQuantize(v.y), bakeQuantize(v.z) };
+        keep[i] = index.insert(k, (int)i);
+    }
+
+    const long step = bakeQuantize(voxelSize);
+    for (size_t i = 0; i < in.count; ++i) {
+        if (!keep[i]) continue;
+        const V& v = in.items[i];
+        BakeKey k = { bakeQuantize(v.x), bakeQuantize(v.y), bakeQuantize(v.z) };
+
+        bool hidden =
+            index.contains({ k.x + step, k.y, k.z }) && index.contains({ k.x - step, k.y, k.z }) &&
+            index.contains({ k.x, k.y + step, k.z }) && index.contains({ k.x, k.y - step, k.z }) &&
+            index.contains({ k.x, k.y, k.z + step }) && index.contains({ k.x, k.y, k.z - step });
+        if (hidden) keep[i] = false;
+    }
+
+    BakeTable<V, N> out;
+    for (size_t i = 0; i < in.count; ++i) {
+        if (keep[i]) out.items[out.count++] = in.items[i];
+    }
+    return out;
+}
+
+// ȡɸպ M Ԫص
+template <size_t M, class V, size_t N>
+constexpr std::array<V, M> bakeShrink(const BakeTable<V, N>& table) {
+    std::array<V, M> out{};
+    for (size_t i = 0; i < M; ++i) out[i] = table.items[i];
+    return out;
+}
+
+#endif // BAKED_MODELS_H
\ No newline at end of file
@@ -0,0 +1,278 @@
+#include "Benchmark.h"
+#include "Camera.h"
+#include "Crowd.h"
+#include "JobSystem.h"
+#include "Models.h"
+#include "Regression.h"
+#include "SceneParams.h"
+#include "SceneState.h"
+#include "Stats.h"
+#include "VoxelQuery.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+// ʱߣغ
+static double nowMs() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+// ɵĶչԲԣ߳ 1  Nÿȡеóɼ
+static int benchLandscape(int argc, char** argv) {
+    int maxThreads = argc > 0 ? atoi(argv[0]) : JobSystem::hardwareThreads();
+    int repeats = argc > 1 ? atoi(argv[1]) : 10;
+    if (maxThreads < 1) maxThreads = 1;
+    if (repeats < 1) repeats = 1;
+
+    // нΪȷԲ
+    size_t expected = createLandscapeModel().size();
+
+    printf("landscape build: %zu voxels, best of %d runs\n", expected, repeats);
+    printf("%8s %12s %10s\n", "threads", "time(ms)", "speedup");
+
+    double baseline = 0.0;
+    for (int n = 1; n <= maxThreads; ++n) {
+        JobSystem jobs(n, true);
+
+        double best = 1e30;
+        for (int i = 0; i < repeats; ++i) {
+            double t0 = nowMs();
+            std::vector<Voxel> model = createLandscapeModel(LandscapeDesc(), &jobs);
+            double t1 = nowMs();
+
+            if (model.size() != expected) {
+                printf("error: %d threads produced %zu voxels, expected %zu\n", n, model.size(), expected);
+                return 1;
+            }
+            if (t1 - t0 < best) best = t1 - t0;
+        }
+
+        if (n == 1) baseline = best;
+        printf("%8d %12.3f %9.2fx\n", n, best, baseline / best);
+    }
+    return 0;
+}
+
+// ÷--bench crowd [maxCount] [frames]
+//  10 ÿֱ· drawCube ·ʱֻ̫⵽ 1000
+static int benchCrowd(int argc, char** argv) {
+    int maxCount = argc > 0 ? atoi(argv[0]) : Crowd::MAX_SIZE;
+    int frames = argc > 1 ? atoi(argv[1]) : 20;
+    const int IMMEDIATE_LIMIT = 1000;
+    const float BENCH_TIME = 12.0f;     // ڶĻԶܿ϶
+
+    if (maxCount < 1) maxCount = 1;
+    if (maxCount > Crowd::MAX_SIZE) maxCount = Crowd::MAX_SIZE;
+    if (frames < 1) frames = 1;
+
+    createJobSystem();
+    openSceneWindow("crowd benchmark", 1280, 720);
+    setSceneTime(BENCH_TIME);
+    Crowd& crowd = sceneCrowd();
+
+    printf("crowd scaling at t = %.1f s, %d frames per step\n", BENCH_TIME, frames);
+    printf("%8s %8s %12s %10s %14s %10s %12s\n", "figures", "visible", "voxels", "packed", "immediate", "draw calls",
+        "allocs/frame");
+
+    RenderPath savedPath = renderPath();
+    for (int count = 1; count <= maxCount; count = count == maxCount ? maxCount + 1 : std::min(count * 10, maxCount)) {
+        crowd.resize(count);
+
+        double ms[2] = { -1.0, -1.0 };
+        int drawCalls = 0;
+        long long voxels = 0;
+        long long allocations = 0;      // ÿ֡ĶѷƵȡͬһ·
+        for (int p = 0; p < 2; ++p) {
+            RenderPath path = p == 0 ? RENDER_PATH_PACKED : RENDER_PATH_IMMEDIATE;
+            if (path == RENDER_PATH_IMMEDIATE && count > IMMEDIATE_LIMIT) continue;
+            if (!setRenderPath(path)) continue;
+
+            // Ȼһ֡Ԥȣϴ塢ɫ壩
+            renderScene(BENCH_TIME);
+            glFinish();
+
+            using Clock = std::chrono::steady_clock;
+            Clock::time_point t0 = Clock::now();
+            HeapCounters heap0 = heapCounters();
+            for (int f = 0; f < frames; ++f) {
+                renderScene(BENCH_TIME + f / 60.0f);
+                glFinish();
+            }
+            ms[p] = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / frames;
+            if (p == 0 || drawCalls == 0) {
+                drawCalls = g_frameStats.drawCalls;
+                voxels = g_frameStats.voxelsSubmitted;
+                allocations = (heapCounters().allocations - heap0.allocations) / frames;
+            }
+        }
+
+        printf("%8d %8d %12lld", count, (int)crowd.visibleInstances().size(), voxels);
+        if (ms[0] >= 0) printf(" %8.2fms", ms[0]); else printf(" %10s", "-");
+        if (ms[1] >= 0) printf(" %12.2fms", ms[1]); else printf(" %14s", "-");
+        printf(" %10d %12lld\n", drawCalls, allocations);
+    }
+    setRenderPath(savedPath);
+    return 0;
+}
+
+// ÷--bench rays [count] [threads]
+// һӸĻλ򳡾ʰȡһǳĶߣײ̽⣩
+static int benchRays(int argc, char** argv) {
+    int count = argc > 0 ? atoi(argv[0]) : 1000000;
+    int threads = argc > 1 ? atoi(argv[1]) : JobSystem::hardwareThreads();
+    const int REPEATS = 3;
+    const int VERIFY_COUNT = 2000;
+    const float PROBE_DISTANCE = 4.0f;
+    if (count < 1) count = 1;
+    if (threads < 1) threads = 1;
+
+    JobSystem* jobs = createJobSystem(threads);
+    loadModels();
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point t0 = Clock::now();
+    const VoxelQuery& world = buildSceneCollision();
+    double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+    const VoxelGrid& grid = world.voxelGrid();
+    float lo[3], hi[3];
+    for (int a = 0; a < 3; ++a) {
+        lo[a] = grid.origin()[a];
+        hi[a] = lo[a] + grid.dims()[a] * grid.cellSize();
+    }
+    printf("%d boxes, grid %.1f MB, build %.1f ms\n", world.boxCount(), grid.memoryBytes() / (1024.0 * 1024.0), buildMs);
+
+    // ƽ̨޹صͬÿеȫͬ
+    unsigned int seed = 2024u;
+    auto random01 = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) / 16777216.0f;
+    };
+
+    std::vector<RayQuery> rays(count);
+    for (int i = 0; i < count; ++i) {
+        RayQuery& ray = rays[i];
+        float target[3];
+        if (i % 2 == 0) {
+            setSceneTime(CAMERA_ACT_TIMES[(i / 2) % CAMERA_ACT_COUNT]);
+            const Camera& camera = sceneCamera();
+            ray.origin[0] = camera.eyeX; ray.origin[1] = camera.eyeY; ray.origin[2] = camera.eyeZ;
+            for (int a = 0; a < 3; ++a) target[a] = lo[a] + (hi[a] - lo[a]) * random01();
+            ray.maxDist = FAR_PLANE;
+        } else {
+            for (int a = 0; a < 3; ++a) {
+                ray.origin[a] = lo[a] + (hi[a] - lo[a]) * random01();
+                target[a] = ray.origin[a] + random01() - 0.5f;
+            }
+            ray.maxDist = PROBE_DISTANCE;
+        }
+        float length = 0.0f;
+        for (int a = 0; a < 3; ++a) {
+            ray.dir[a] = target[a] - ray.origin[a];
+            length += ray.dir[a] * ray.dir[a];
+        }
+        length = sqrt(length);
+        if (length <= 0.0f) { ray.dir[0] = 0.0f; ray.dir[1] = -1.0f; ray.dir[2] = 0.0f; length = 1.0f; }
+        for (int a = 0; a < 3; ++a) ray.dir[a] /= length;
+    }
+
+    // ȷԣǰһߺ鱩󽻵ĽԱ
+    std::vector<VoxelHit> results(count);
+    world.raycastBatch(rays.data(), count, results.data(), jobs);
+    const std::vector<VoxelBox>& boxes = grid.boxes();
+    int mismatches = 0;
+    for (int i = 0; i < std::min(count, VERIFY_COUNT); ++i) {
+        const RayQuery& ray = rays[i];
+        float inv[3];
+        for (int a = 0; a < 3; ++a) inv[a] = 1.0f / (std::fabs(ray.dir[a]) < 1e-12f ? 1e-12f : ray.dir[a]);
+        float best = ray.maxDist;
+        bool found = false;
+        for (const auto& b : boxes) {
+            float t;
+            if (VoxelGrid::intersectBox(b, ray.origin, inv, 0.0f, best, t)) { best = t; found = true; }
+        }
+        bool hit = results[i].box >= 0;
+        if (hit != found || (hit && std::fabs(results[i].t - best) > 1e-3f)) ++mismatches;
+    }
+    if (mismatches > 0) {
+        printf("error: %d of %d rays differ from brute force\n", mismatches, std::min(count, VERIFY_COUNT));
+        return 1;
+    }
+
+    int hits = 0;
+    for (const auto& r : results) hits += r.box >= 0;
+    printf("%d rays (%.1f%% hit), verified %d against brute force, best of %d runs, %d threads\n",
+        count, 100.0 * hits / count, std::min(count, VERIFY_COUNT), REPEATS, jobs->threadCount());
+    printf("%-22s %10s %12s\n", "query", "time(ms)", "Mrays/s");
+
+    auto report = [&](const char* name, const std::function<void()>& run) {
+        double best = 1e30;
+        for (int r = 0; r < REPEATS; ++r) {
+            Clock::time_point start = Clock::now();
+            run();
+            best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+        printf("%-22s %10.2f %12.2f\n", name, best, count / (best * 1000.0));
+    };
+
+    report("closest hit, 1 thread", [&]() {
+        for (int i = 0; i < count; ++i) {
+            if (!world.raycast(rays[i].origin, rays[i].dir, rays[i].maxDist, results[i])) results[i].box = -1;
+        }
+    });
+    report("closest hit, batched", [&]() { world.raycastBatch(rays.data(), count, results.data(), jobs); });
+    int blocked = 0;
+    report("any hit, 1 thread", [&]() {
+        blocked = 0;
+        for (int i = 0; i < count; ++i) blocked += world.occluded(rays[i].origin, rays[i].dir, rays[i].maxDist);
+    });
+    if (blocked != hits) {
+        printf("error: any-hit found %d blocked rays, closest-hit found %d\n", blocked, hits);
+        return 1;
+    }
+    return 0;
+}
+
+struct BenchmarkEntry {
+    const char* name;
+    BenchmarkFunc func;
+};
+
+static std::vector<BenchmarkEntry>& benchmarks() {
+    static std::vector<BenchmarkEntry> list = {
+        { "landscape", benchLandscape },
+        { "crowd", benchCrowd },
+        { "rays", benchRays },
+        { "regression", runRegressionBenchmark }
+    };
+    return list;
+}
+
+void registerBenchmark(const char* name, BenchmarkFunc func) {
+    for (auto& entry : benchmarks()) {
+        if (strcmp(entry.name, name) == 0) {
+            entry.func = func;
+            return;
+        }
+    }
+    benchmarks().push_back({ name, func });
+}
+
+int runBenchmark(const char* name, int argc, char** argv) {
+    for (const auto& entry : benchmarks()) {
+        if (strcmp(entry.name, name) == 0) return entry.func(argc, argv);
+    }
+
+    printf("unknown benchmark: %s\n", name);
+    printf("available:");
+    for (const auto& entry : benchmarks()) printf(" %s", entry.name);
+    printf("\n");
+    return 1;
+}
\ No newline at end of file
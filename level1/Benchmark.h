@@ -0,0 +1,16 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+// л׼ڣ÷
+//   main --bench landscape [maxThreads] [repeats]
+//   main --bench crowd [maxCount] [frames]
+//   main --bench rays [count] [threads]
+//   main --bench regression [goldenDir] [update]
+// ֵΪ˳룬0 ʾɹ
+int runBenchmark(const char* name, int argc, char** argv);
+
+// ģҲʱעԣͬʱ滻еģ
+typedef int (*BenchmarkFunc)(int argc, char** argv);
+void registerBenchmark(const char* name, BenchmarkFunc func);
+
+#endif // BENCHMARK_H
\ No newline at end of file
@@ -3,6 +3,14 @@
 #include <cmath>
 #include <algorithm>
 #include <iostream> // ڴӡʾ
+#include "Input.h"
+#include "VoxelQuery.h"
+
+// ģʽײа߳
+static const float CAMERA_HALF_EXTENT[3] = { 0.3f, 0.3f, 0.3f };
+
+static const float MOVE_SPEED = 15.0f;   // ƶٶȣλ/룩
+static const float TURN_SPEED = 1.5f;    // תٶȣ/룩
 
 Camera::Camera() {
     eyeX = 0.0f; eyeY = 10.0f; eyeZ = 30.0f;
@@ -92,11 +100,13 @@ void Camera::handleKey(unsigned char key) {
     if (key == 'c' || key == 'C') {
         isFreeMode = !isFreeMode;
         std::cout << (isFreeMode ? "Free Mode ON" : "Auto Mode ON") << std::endl;
-        return;
     }
+}
 
+// [] ģʽƶÿ֡İ״̬ƶ = ٶ * ֡
+void Camera::updateMovement(const InputState& input, float dt) {
     // ģʽӦƶ
-    if (!isFreeMode) return;
+    if (!isFreeMode || dt <= 0.0f) return;
 
     // 㵱ǰ (Forward Vector)
     float dx = centerX - eyeX;
@@ -112,55 +122,51 @@ void Camera::handleKey(unsigned char key) {
     float rx = -dz;
     float rz = dx;
 
-    float moveSpeed = 1.0f;   // ƶٶ
-    float rotSpeed = 0.1f;    // תٶ
-
-    switch (key) {
-        // --- ƶ (WASD) ---
-    case 'w': case 'W': // ǰ
-        eyeX += dx * moveSpeed; eyeZ += dz * moveSpeed;
-        centerX += dx * moveSpeed; centerZ += dz * moveSpeed;
-        break;
-    case 's': case 'S': // 
-        eyeX -= dx * moveSpeed; eyeZ -= dz * moveSpeed;
-        centerX -= dx * moveSpeed; centerZ -= dz * moveSpeed;
-        break;
-    case 'a': case 'A': // ƽ
-        eyeX -= rx * moveSpeed; eyeZ -= rz * moveSpeed;
-        centerX -= rx * moveSpeed; centerZ -= rz * moveSpeed;
-        break;
-    case 'd': case 'D': // ƽ
-        eyeX += rx * moveSpeed; eyeZ += rz * moveSpeed;
-        centerX += rx * moveSpeed; centerZ += rz * moveSpeed;
-        break;
-
-        // --- תӽ (Q/E) ---
-    case 'q': case 'Q': // ת
-        // Χ eye ת center
-    {
-        float newDx = dx * cos(-rotSpeed) - dz * sin(-rotSpeed);
-        float newDz = dx * sin(-rotSpeed) + dz * cos(-rotSpeed);
+    // --- תӽ (Q/E)Χ eye ת center ---
+    float turn = 0.0f;
+    if (input.held('q')) turn -= TURN_SPEED * dt; // ת
+    if (input.held('e')) turn += TURN_SPEED * dt; // ת
+    if (turn != 0.0f) {
+        float newDx = dx * cos(turn) - dz * sin(turn);
+        float newDz = dx * sin(turn) + dz * cos(turn);
         centerX = eyeX + newDx * length;
         centerZ = eyeZ + newDz * length;
+        dx = newDx; dz = newDz;
+        rx = -dz; rz = dx;
     }
-    break;
-    case 'e': case 'E': // ת
-    {
-        float newDx = dx * cos(rotSpeed) - dz * sin(rotSpeed);
-        float newDz = dx * sin(rotSpeed) + dz * cos(rotSpeed);
-        centerX = eyeX + newDx * length;
-        centerZ = eyeZ + newDz * length;
+
+    // --- ƶ (WASD)  (R/F) ---
+    float forward = 0.0f, strafe = 0.0f, rise = 0.0f;
+    if (input.held('w')) forward += 1.0f;
+    if (input.held('s')) forward -= 1.0f;
+    if (input.held('d')) strafe += 1.0f;
+    if (input.held('a')) strafe -= 1.0f;
+    if (input.held('r')) rise += 1.0f;
+    if (input.held('f')) rise -= 1.0f;
+
+    // бֱ߲߿
+    float mx = dx * forward + rx * strafe;
+    float mz = dz * forward + rz * strafe;
+    float planar = sqrt(mx * mx + mz * mz);
+    if (planar > 1.0f) { mx /= planar; mz /= planar; }
+
+    float step = MOVE_SPEED * dt;
+    if (mx != 0.0f || mz != 0.0f || rise != 0.0f) {
+        move(mx * step, rise * step, mz * step);
     }
-    break;
-
-    // ---  (R/F) ---
-    case 'r': case 'R': // 
-        eyeY += moveSpeed; centerX += moveSpeed;
-        break;
-    case 'f': case 'F': // 
-        eyeY -= moveSpeed; centerX -= moveSpeed;
-        break;
+}
+
+void Camera::move(float dx, float dy, float dz) {
+    float eye[3] = { eyeX, eyeY, eyeZ };
+    float delta[3] = { dx, dy, dz };
+    if (collider) {
+        collider->moveWithCollision(eye, delta, CAMERA_HALF_EXTENT);
+    } else {
+        for (int a = 0; a < 3; ++a) eye[a] += delta[a];
     }
+
+    centerX += eye[0] - eyeX; centerY += eye[1] - eyeY; centerZ += eye[2] - eyeZ;
+    eyeX = eye[0]; eyeY = eye[1]; eyeZ = eye[2];
 }
 
 void Camera::applyView() {
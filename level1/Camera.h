@@ -1,6 +1,13 @@
 #ifndef CAMERA_H
 #define CAMERA_H
 
+class InputState;
+class VoxelQuery;
+
+// Զ˾ 5 ĻÿĻȡһʱ̣룩׼Ժͻع԰ЩʱȾ
+const int CAMERA_ACT_COUNT = 5;
+const float CAMERA_ACT_TIMES[CAMERA_ACT_COUNT] = { 2.5f, 7.5f, 12.0f, 19.5f, 25.0f };
+
 // ࣬ͼ任
 class Camera {
 public:
@@ -22,8 +29,20 @@ public:
     // ͼӦõ
     void applyView();
 
-    // [] 
+    // [] 루ֻ C лģʽһԲ
     void handleKey(unsigned char key);
+
+    // ģʽ°֡İ״̬ƶdt һ֡ļ룩
+    void updateMovement(const InputState& input, float dt);
+
+    // ģʽµײúᴩ飨 nullptr رգ
+    void setCollider(const VoxelQuery* query) { collider = query; }
+
+private:
+    // ۾Ŀһƽƣײʱŷ滬
+    void move(float dx, float dy, float dz);
+
+    const VoxelQuery* collider = nullptr;
 };
 
 #endif // CAMERA_H
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "CpuRender.h"
+#include "JobSystem.h"
+#include "SceneState.h"
+#include "SoftwareRenderer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+int runCpuRender(int argc, char** argv) {
+    const char* path = argv[0];
+    float time = argc > 1 ? (float)atof(argv[1]) : 0.0f;
+    int width = argc > 3 ? atoi(argv[2]) : 1280;
+    int height = argc > 3 ? atoi(argv[3]) : 720;
+    if (width <= 0 || height <= 0) {
+        printf("invalid image size %d x %d\n", width, height);
+        return 1;
+    }
+
+    JobSystem* jobs = createJobSystem();
+    loadModels();
+    setSceneTime(time);
+
+    SoftwareRenderer renderer(width, height);
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point t0 = Clock::now();
+    buildCpuScene(renderer, time);
+    Clock::time_point t1 = Clock::now();
+    renderer.render(sceneCamera(), jobs);
+    Clock::time_point t2 = Clock::now();
+
+    printf("%zu boxes, grid %.1f MB, build %.1f ms, render %.1f ms (%d threads)\n",
+        renderer.boxCount(), renderer.grid().memoryBytes() / (1024.0 * 1024.0),
+        std::chrono::duration<double, std::milli>(t1 - t0).count(),
+        std::chrono::duration<double, std::milli>(t2 - t1).count(), jobs->threadCount());
+
+    if (!renderer.writeImage(path)) {
+        printf("failed to write %s\n", path);
+        return 1;
+    }
+    printf("wrote %s (%d x %d)\n", path, width, height);
+    return 0;
+}
\ No newline at end of file
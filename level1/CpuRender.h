@@ -0,0 +1,9 @@
+#ifndef CPU_RENDER_H
+#define CPU_RENDER_H
+
+// Ⱦģʽû GPU ĻãڣֱͼƬ
+// ÷main --cpu-render <out.ppm> [time] [width height]
+// ֵΪ˳룬0 ʾɹ
+int runCpuRender(int argc, char** argv);
+
+#endif // CPU_RENDER_H
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "Crowd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "JobSystem.h"
+#include "Models.h"
+
+const float Crowd::BOUND_CENTER_Y = 6.5f;
+const float Crowd::BOUND_RADIUS = 8.0f;    //  -0.5 ~ 13.5ֱ 3.05۾ z = 1.875
+
+static const float CROWD_SPACING = 7.0f;
+static const int CULL_BLOCK = 4096;         // ޳ںÿʵ
+
+Crowd::Crowd() {}
+
+void Crowd::resize(int count) {
+    count = std::max(0, std::min(count, MAX_SIZE));
+    all.clear();
+    all.reserve(count);
+
+    // 򵥵ͬƽ̨޹أҲӰģʹõ rand() 
+    unsigned int state = 12345u;
+    auto random01 = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) / 16777216.0f;
+    };
+
+    // һȦһȦ
+    for (int ring = 0; (int)all.size() < count; ++ring) {
+        for (int j = -ring; j <= ring && (int)all.size() < count; ++j) {
+            for (int i = -ring; i <= ring && (int)all.size() < count; ++i) {
+                if (std::max(std::abs(i), std::abs(j)) != ring) continue;
+
+                CrowdInstance inst;
+                inst.x = i * CROWD_SPACING;
+                inst.z = j * CROWD_SPACING;
+                inst.yaw = 0.0f;
+                inst.phase = 0.0f;
+                if (ring > 0) {
+                    inst.yaw = (random01() - 0.5f) * 0.8f;
+                    inst.phase = random01() * 6.2831853f;
+                }
+                all.push_back(inst);
+            }
+        }
+    }
+}
+
+int Crowd::cull(const float planes[6][4], JobSystem* jobs) {
+    int n = size();
+    int blocks = (n + CULL_BLOCK - 1) / CULL_BLOCK;
+    inside.resize(n);
+    blockOffsets.assign(blocks + 1, 0);
+
+    float lengths[6];
+    for (int p = 0; p < 6; ++p) {
+        lengths[p] = std::sqrt(planes[p][0] * planes[p][0] + planes[p][1] * planes[p][1] + planes[p][2] * planes[p][2]);
+    }
+
+    // 1. ÿ԰Χ򲢼
+    auto testBlocks = [&](int first, int last) {
+        for (int b = first; b < last; ++b) {
+            int begin = b * CULL_BLOCK;
+            int end = std::min(n, begin + CULL_BLOCK);
+            int count = 0;
+            for (int i = begin; i < end; ++i) {
+                const CrowdInstance& inst = all[i];
+                bool in = true;
+                for (int p = 0; p < 6 && in; ++p) {
+                    const float* pl = planes[p];
+                    float d = pl[0] * inst.x + pl[1] * BOUND_CENTER_Y + pl[2] * inst.z + pl[3];
+                    in = d >= -BOUND_RADIUS * lengths[p];
+                }
+                inside[i] = in;
+                count += in;
+            }
+            blockOffsets[b + 1] = count;
+        }
+    };
+
+    // 2. ǰ׺͵õÿдλãٲѹ
+    auto compactBlocks = [&](int first, int last) {
+        for (int b = first; b < last; ++b) {
+            int out = blockOffsets[b];
+            int end = std::min(n, (b + 1) * CULL_BLOCK);
+            for (int i = b * CULL_BLOCK; i < end; ++i) {
+                if (inside[i]) visible[out++] = all[i];
+            }
+        }
+    };
+
+    if (jobs) jobs->parallelFor(0, blocks, 1, testBlocks);
+    else testBlocks(0, blocks);
+
+    for (int b = 0; b < blocks; ++b) blockOffsets[b + 1] += blockOffsets[b];
+    visible.resize(blockOffsets[blocks]);
+
+    if (jobs) jobs->parallelFor(0, blocks, 1, compactBlocks);
+    else compactBlocks(0, blocks);
+
+    return (int)visible.size();
+}
+
+void Crowd::animate(float time, JobSystem* jobs) {
+    visiblePoses.resize(visible.size());
+
+    auto kernel = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            float t = time + visible[i].phase;
+            CrowdPose& pose = visiblePoses[i];
+            pose.breathScale = breathScaleAt(t);
+            pose.browOffset = faceBrowOffset(t);
+            pose.glintX = faceGlintPosition(t);
+            pose.glintVisible = faceGlintVisible(pose.glintX);
+        }
+    };
+
+    if (jobs) jobs->parallelFor(0, (int)visible.size(), 1024, kernel);
+    else kernel(0, (int)visible.size());
+}
+
+size_t Crowd::memoryBytes() const {
+    return (all.capacity() + visible.capacity()) * sizeof(CrowdInstance) +
+        visiblePoses.capacity() * sizeof(CrowdPose) +
+        inside.capacity() * sizeof(unsigned char) +
+        blockOffsets.capacity() * sizeof(int);
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef CROWD_H
+#define CROWD_H
+
+#include <cstddef>
+#include <vector>
+
+class JobSystem;
+
+// ȺģʽԻ + ֱ +  N ݣѹ
+// ʵ 0 ԭǸˣλڵԭ㣩ఴλ
+// λöԳͼڵ㣨FIGURE_POSITION
+struct CrowdInstance {
+    float x, z;         // ڵλ
+    float yaw;          //  Y תȣ
+    float phase;        // ʱƫƣ룩üⶼ time + phase
+};
+
+// ĳһ֡һʵĶ״̬drawCube ·ʹãGPU ·ɫ㣩
+struct CrowdPose {
+    float breathScale;
+    float browOffset;
+    float glintX;
+    bool glintVisible;
+};
+
+class Crowd {
+public:
+    static const int MAX_SIZE = 100000;
+
+    // İΧԽģ׶޳
+    static const float BOUND_CENTER_Y;
+    static const float BOUND_RADIUS;
+
+    Crowd();
+
+    //  count ʵλáλȷģ rand()
+    void resize(int count);
+    int size() const { return (int)all.size(); }
+
+    // ںˣ׶޳ѹɼʵԭ˳planes ڵľֲռ䣩
+    int cull(const float planes[6][4], JobSystem* jobs);
+    const std::vector<CrowdInstance>& visibleInstances() const { return visible; }
+
+    // ںˣɼʵ time ʱ̵Ķ״̬
+    void animate(float time, JobSystem* jobs);
+    const std::vector<CrowdPose>& poses() const { return visiblePoses; }
+
+    // ʵ޳õʱռõڴ
+    size_t memoryBytes() const;
+
+private:
+    std::vector<CrowdInstance> all;
+    std::vector<CrowdInstance> visible;
+    std::vector<CrowdPose> visiblePoses;
+    std::vector<unsigned char> inside;
+    std::vector<int> blockOffsets;
+};
+
+#endif // CROWD_H
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+static const float SMOOTHING = 0.2f;            // ָƽϵԼ 5 ֡Ĵ
+static const float UPSCALE_HEADROOM = 0.75f;    // ƽʱĿֱ
+static const float UPSCALE_STEP = 0.05f;        // ÿߵţһԼ 10-20%ԽĿ
+static const float MIN_CHANGE = 0.01f;          // СĵԵÿ֡ڶ
+static const float MAX_SAMPLE_RATIO = 4.0f;     // صĿ 4 żĿ٣ءȼأƽֵ̫ͣ
+static const int SETTLE_FRAMES = 2;
+
+static int glVersion() {
+    int major = 0, minor = 0;
+    const char* version = (const char*)glGetString(GL_VERSION);
+    if (!version || sscanf(version, "%d.%d", &major, &minor) != 2) return 0;
+    return major * 10 + minor;
+}
+
+DynamicResolution::DynamicResolution()
+    : framebuffer(0), colorBuffer(0), depthBuffer(0), previousFramebuffer(0), offscreen(false),
+      windowWidth(0), windowHeight(0), allocatedWidth(0), allocatedHeight(0),
+      active(true), targetMs(DEFAULT_TARGET_MS), currentScale(1.0f), smoothedMs(-1.0f), settleFrames(0) {}
+
+bool DynamicResolution::init() {
+    if (glVersion() < 30 || !hasFramebuffers()) return false;
+
+    glGenFramebuffers(1, &framebuffer);
+    glGenRenderbuffers(1, &colorBuffer);
+    glGenRenderbuffers(1, &depthBuffer);
+    if (windowWidth > 0 && windowHeight > 0) allocate();
+    return ready();
+}
+
+void DynamicResolution::setEnabled(bool on) {
+    active = on;
+    if (!on && currentScale != 1.0f) setScale(1.0f);
+}
+
+void DynamicResolution::resize(int width, int height) {
+    windowWidth = width;
+    windowHeight = height;
+    if (ready()) allocate();
+}
+
+// ڴС䣻ʱĿ֮꣬һֱֱӻ
+void DynamicResolution::allocate() {
+    if (windowWidth <= 0 || windowHeight <= 0) return;
+    if (allocatedWidth == windowWidth && allocatedHeight == windowHeight) return;
+
+    GLint previous = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previous);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, windowWidth, windowHeight);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, windowWidth, windowHeight);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, previous);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        printf("dynamic resolution unavailable (framebuffer status 0x%x)\n", status);
+        glDeleteFramebuffers(1, &framebuffer);
+        glDeleteRenderbuffers(1, &colorBuffer);
+        glDeleteRenderbuffers(1, &depthBuffer);
+        framebuffer = colorBuffer = depthBuffer = 0;
+        currentScale = 1.0f;
+        return;
+    }
+    allocatedWidth = windowWidth;
+    allocatedHeight = windowHeight;
+}
+
+int DynamicResolution::renderWidth() const {
+    return std::max(1, (int)(windowWidth * currentScale + 0.5f));
+}
+
+int DynamicResolution::renderHeight() const {
+    return std::max(1, (int)(windowHeight * currentScale + 0.5f));
+}
+
+void DynamicResolution::beginScene() {
+    offscreen = ready() && currentScale < 1.0f && allocatedWidth > 0;
+    if (offscreen) {
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        // ֻͻõ½
+        glViewport(0, 0, renderWidth(), renderHeight());
+        glScissor(0, 0, renderWidth(), renderHeight());
+        glEnable(GL_SCISSOR_TEST);
+    }
+}
+
+void DynamicResolution::presentScene() {
+    if (!offscreen) return;
+
+    glDisable(GL_SCISSOR_TEST);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, previousFramebuffer);
+    glBlitFramebuffer(0, 0, renderWidth(), renderHeight(), 0, 0, windowWidth, windowHeight,
+        GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+    glViewport(0, 0, windowWidth, windowHeight);
+    offscreen = false;
+}
+
+void DynamicResolution::update(double frameMs) {
+    if (settleFrames > 0) {
+        settleFrames--;
+        return;
+    }
+    float ms = std::min((float)frameMs, targetMs * MAX_SAMPLE_RATIO);
+    smoothedMs = smoothedMs < 0.0f ? ms : smoothedMs + SMOOTHING * (ms - smoothedMs);
+    if (!active || !ready()) return;
+
+    // ĿʱһνλиʱһСһС
+    float next = currentScale;
+    if (smoothedMs > targetMs) next = currentScale * sqrtf(targetMs / smoothedMs);
+    else if (smoothedMs < targetMs * UPSCALE_HEADROOM) next = currentScale + UPSCALE_STEP;
+    next = std::min(std::max(next, MIN_SCALE), 1.0f);
+    if (fabsf(next - currentScale) < MIN_CHANGE && next != 1.0f) return;
+    if (next == currentScale) return;
+
+    setScale(next);
+}
+
+// Ԥ·ֱµʱ䣬·ϵľɷֱ
+void DynamicResolution::setScale(float next) {
+    if (smoothedMs > 0.0f) smoothedMs *= (next * next) / (currentScale * currentScale);
+    currentScale = next;
+    settleFrames = SETTLE_FRAMES;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include "GLExt.h"
+
+// ֱ̬ʣ֡ԤʱȾֱʣ쵽
+// - Ŀ꣨ɫ + Ⱦ壩ڴСһΣʱֻ½ scale *  
+//   ıŲҪ·䣻scale Ϊ 1 ʱĿֱ꣬ӻ
+// - ÿ֡ display() ĺʱΪֹ GL Ĺդ򽻻ʱִУ
+//   档llvmpipe  GL_TIME_ELAPSED ѯⲿ֣ԲüʱѯָƽĿȽϣ
+//   ʱ   scale^2 һνλĿ UPSCALE_HEADROOM ʱȥ
+// -  glBlitFramebuffer ԹˣHUD ֮󻭣ִڷֱ
+// - Ҫ GL 3.0 ֡󣬲֧ʱ init()  falseһֱڷֱʻ
+class DynamicResolution {
+public:
+    static constexpr float MIN_SCALE = 0.5f;
+    static constexpr float DEFAULT_TARGET_MS = 14.0f;   // glutTimerFunc  16 ms ȥ졢HUD ͽ
+
+    DynamicResolution();
+
+    bool init();
+    bool ready() const { return framebuffer != 0; }
+
+    // رʱ scale ص 1ֹͣ
+    void setEnabled(bool on);
+    bool enabled() const { return active; }
+
+    void setTargetMs(float ms) { targetMs = ms; }
+    float target() const { return targetMs; }
+
+    // ڴСı䣨reshape
+    void resize(int width, int height);
+
+    // ֮ǰҪʱĿ꣬ӿΪȾֱ
+    void beginScene();
+    // 곡ȾֱʵĻ쵽ԭ֡壬ӿڻָΪڴС
+    void presentScene();
+
+    // һ֮֡󣩣frameMs һ֡ӽĺʱһ֡
+    void update(double frameMs);
+
+    float scale() const { return currentScale; }
+    int renderWidth() const;
+    int renderHeight() const;
+    float frameMs() const { return smoothedMs; }    // ƽ֡ʱûʱ < 0
+
+private:
+    void allocate();
+    void setScale(float next);
+
+    GLuint framebuffer;
+    GLuint colorBuffer;
+    GLuint depthBuffer;
+    GLint previousFramebuffer;      // beginScene() ֮ǰ󶨵֡壨 0
+    bool offscreen;                 // һ֡Ŀ
+    int windowWidth, windowHeight;
+    int allocatedWidth, allocatedHeight;
+
+    bool active;
+    float targetMs;
+    float currentScale;
+    float smoothedMs;
+    int settleFrames;               // ŸıҪܻڻɷֱʵ֡
+};
+
+#endif // DYNAMIC_RESOLUTION_H
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "FileWatcher.h"
+
+#include <chrono>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <cstring>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+static const double POLL_INTERVAL_MS = 250.0;
+
+static double steadyMs() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+FileWatcher::FileWatcher()
+    : notifyFd(-1), notifyHandle(nullptr), lastStamp(-1), lastSize(-1), lastPollMs(0.0), pendingSinceMs(-1.0) {}
+
+FileWatcher::~FileWatcher() {
+    close();
+}
+
+void FileWatcher::close() {
+#ifdef _WIN32
+    if (notifyHandle) FindCloseChangeNotification((HANDLE)notifyHandle);
+#elif defined(__linux__)
+    if (notifyFd >= 0) ::close(notifyFd);
+#endif
+    notifyFd = -1;
+    notifyHandle = nullptr;
+}
+
+bool FileWatcher::watch(const char* path) {
+    close();
+    filePath = path;
+    size_t slash = filePath.find_last_of("/\\");
+    directory = slash == std::string::npos ? "." : filePath.substr(0, slash == 0 ? 1 : slash);
+    fileName = slash == std::string::npos ? filePath : filePath.substr(slash + 1);
+    pendingSinceMs = -1.0;
+    statChanged(); // µǰ޸ʱʹС
+
+#ifdef _WIN32
+    HANDLE h = FindFirstChangeNotificationA(directory.c_str(), FALSE,
+        FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE);
+    if (h != INVALID_HANDLE_VALUE) notifyHandle = h;
+#elif defined(__linux__)
+    notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (notifyFd >= 0 &&
+        inotify_add_watch(notifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE) < 0) {
+        ::close(notifyFd);
+        notifyFd = -1;
+    }
+#endif
+    return true;
+}
+
+bool FileWatcher::readNotifications() {
+#ifdef _WIN32
+    if (notifyHandle) {
+        bool signaled = false;
+        while (WaitForSingleObject((HANDLE)notifyHandle, 0) == WAIT_OBJECT_0) {
+            signaled = true;
+            if (!FindNextChangeNotification((HANDLE)notifyHandle)) break;
+        }
+        // ֪ͨļֻļ˲
+        return signaled && statChanged();
+    }
+#elif defined(__linux__)
+    if (notifyFd >= 0) {
+        bool relevant = false;
+        alignas(struct inotify_event) char buffer[4096];
+        for (;;) {
+            ssize_t n = read(notifyFd, buffer, sizeof(buffer));
+            if (n <= 0) break;
+            for (char* p = buffer; p < buffer + n;) {
+                const struct inotify_event* e = (const struct inotify_event*)p;
+                if (e->len > 0 && strcmp(e->name, fileName.c_str()) == 0) relevant = true;
+                p += sizeof(struct inotify_event) + e->len;
+            }
+        }
+        if (relevant) statChanged();
+        return relevant;
+    }
+#endif
+    double now = steadyMs();
+    if (now - lastPollMs < POLL_INTERVAL_MS) return false;
+    lastPollMs = now;
+    return statChanged();
+}
+
+bool FileWatcher::statChanged() {
+    long long stamp = -1, size = -1;
+#ifdef _WIN32
+    struct _stat64 st;
+    if (_stat64(filePath.c_str(), &st) == 0) {
+        stamp = (long long)st.st_mtime;
+        size = (long long)st.st_size;
+    }
+#else
+    struct stat st;
+    if (stat(filePath.c_str(), &st) == 0) {
+#if defined(__linux__)
+        stamp = (long long)st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+#else
+        stamp = (long long)st.st_mtime;
+#endif
+        size = (long long)st.st_size;
+    }
+#endif
+    bool changed = stamp != lastStamp || size != lastSize;
+    lastStamp = stamp;
+    lastSize = size;
+    return changed;
+}
+
+bool FileWatcher::poll() {
+    if (filePath.empty()) return false;
+
+    double now = steadyMs();
+    if (readNotifications()) pendingSinceMs = now;
+    if (pendingSinceMs < 0.0 || now - pendingSinceMs < DEBOUNCE_MS) return false;
+
+    pendingSinceMs = -1.0;
+    return true;
+}
\ No newline at end of file
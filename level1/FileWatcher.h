@@ -0,0 +1,45 @@
+#ifndef FILE_WATCHER_H
+#define FILE_WATCHER_H
+
+#include <string>
+
+// һļǷ޸ģ scene.txt ȼãÿ̵֡߳ poll()
+// - Linuxinotify ļĿ¼ļˣ༭дʱļٸı淽ʽҲյ
+// - WindowsFindFirstChangeNotification Ŀ¼յ֪ͨȽļ޸ʱʹС
+// - ƽ̨ÿ 250 ms Ƚһ޸ʱʹС
+// ʱü¼һ¼֮󰲾 DEBOUNCE_MS һ޸
+class FileWatcher {
+public:
+    static const int DEBOUNCE_MS = 50;
+
+    FileWatcher();
+    ~FileWatcher();
+
+    // ʼ pathļʱڣƽ̨֪ͨʱ˻ѯǷ true
+    bool watch(const char* path);
+
+    // ļϴη true ֮޸ĹѾʱ true
+    bool poll();
+
+    const std::string& path() const { return filePath; }
+
+private:
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    bool readNotifications();   // ļص֪ͨʱ true
+    bool statChanged();         // ޸ʱСϴμ¼Ĳͬʱ true
+    void close();
+
+    std::string filePath;
+    std::string directory;
+    std::string fileName;
+    int notifyFd;               // Linuxinotify 
+    void* notifyHandle;         // WindowsĿ¼仯֪ͨ
+    long long lastStamp;        // ޸ʱ䣨룩
+    long long lastSize;
+    double lastPollMs;          // ѯģʽϴμʱ
+    double pendingSinceMs;      // һ¼ʱ䣬< 0 ʾûд޸
+};
+
+#endif // FILE_WATCHER_H
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "GLExt.h"
+
+#include <cstdio>
+#include <vector>
+
+#ifdef _WIN32
+// glut.h Ѿ windows.hwglGetProcAddress ֱӿ
+#else
+#include <GL/glx.h>
+#endif
+
+#define VOXEL_GL_DEFINE(ret, name, params) name##_proc voxel_##name = nullptr;
+VOXEL_GL_FUNCTIONS(VOXEL_GL_DEFINE)
+VOXEL_GL_OPTIONAL_FUNCTIONS(VOXEL_GL_DEFINE)
+VOXEL_GL_FRAMEBUFFER_FUNCTIONS(VOXEL_GL_DEFINE)
+#undef VOXEL_GL_DEFINE
+
+static void* getProc(const char* name) {
+#ifdef _WIN32
+    return (void*)wglGetProcAddress(name);
+#else
+    return (void*)glXGetProcAddressARB((const GLubyte*)name);
+#endif
+}
+
+bool loadGLExtensions() {
+    bool ok = true;
+
+#define VOXEL_GL_LOAD(ret, name, params) \
+    voxel_##name = (name##_proc)getProc(#name); \
+    if (!voxel_##name) { printf("missing GL function: %s\n", #name); ok = false; }
+    VOXEL_GL_FUNCTIONS(VOXEL_GL_LOAD)
+#undef VOXEL_GL_LOAD
+
+#define VOXEL_GL_LOAD_OPTIONAL(ret, name, params) voxel_##name = (name##_proc)getProc(#name);
+    VOXEL_GL_OPTIONAL_FUNCTIONS(VOXEL_GL_LOAD_OPTIONAL)
+    VOXEL_GL_FRAMEBUFFER_FUNCTIONS(VOXEL_GL_LOAD_OPTIONAL)
+#undef VOXEL_GL_LOAD_OPTIONAL
+
+    return ok;
+}
+
+bool hasStagedUploads() {
+    bool ok = true;
+#define VOXEL_GL_CHECK(ret, name, params) if (!voxel_##name) ok = false;
+    VOXEL_GL_OPTIONAL_FUNCTIONS(VOXEL_GL_CHECK)
+#undef VOXEL_GL_CHECK
+    return ok;
+}
+
+bool hasFramebuffers() {
+    bool ok = true;
+#define VOXEL_GL_CHECK(ret, name, params) if (!voxel_##name) ok = false;
+    VOXEL_GL_FRAMEBUFFER_FUNCTIONS(VOXEL_GL_CHECK)
+#undef VOXEL_GL_CHECK
+    return ok;
+}
+
+static GLuint compileShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint status = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (!status) {
+        GLint length = 0;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+        std::vector<GLchar> log(length + 1, 0);
+        glGetShaderInfoLog(shader, length, nullptr, log.data());
+        printf("shader compile error:\n%s\n", log.data());
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+GLuint buildShaderProgram(const char* vertexSource, const char* fragmentSource, const char* const* attributes) {
+    GLuint vs = compileShader(GL_VERTEX_SHADER, vertexSource);
+    GLuint fs = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
+    if (!vs || !fs) return 0;
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    for (GLuint i = 0; attributes && attributes[i]; ++i) {
+        glBindAttribLocation(program, i, attributes[i]);
+    }
+    glLinkProgram(program);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLint status = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (!status) {
+        GLint length = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+        std::vector<GLchar> log(length + 1, 0);
+        glGetProgramInfoLog(program, length, nullptr, log.data());
+        printf("shader link error:\n%s\n", log.data());
+        return 0;
+    }
+    return program;
+}
\ No newline at end of file
@@ -0,0 +1,224 @@
+#ifndef GL_EXT_H
+#define GL_EXT_H
+
+#include <GL/glut.h>
+#include <cstddef>
+#include <cstdint>
+
+// OpenGL 1.1 ֮ĺҪʱȡַWindows Դͷļֻ 1.1
+// ﲻ GLEWֻرĿõĺʧʱȾ˻ص drawCube ·
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+typedef char GLchar;
+typedef ptrdiff_t GLsizeiptr;
+typedef ptrdiff_t GLintptr;
+typedef uint64_t GLuint64;
+typedef struct __GLsync* GLsync;
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_DYNAMIC_DRAW
+#define GL_DYNAMIC_DRAW 0x88E8
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+#ifndef GL_INFO_LOG_LENGTH
+#define GL_INFO_LOG_LENGTH 0x8B84
+#endif
+#ifndef GL_RGBA32F
+#define GL_RGBA32F 0x8814
+#endif
+#ifndef GL_COPY_READ_BUFFER
+#define GL_COPY_READ_BUFFER 0x8F36
+#endif
+#ifndef GL_COPY_WRITE_BUFFER
+#define GL_COPY_WRITE_BUFFER 0x8F37
+#endif
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_MAP_INVALIDATE_RANGE_BIT
+#define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#endif
+#ifndef GL_MAP_UNSYNCHRONIZED_BIT
+#define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+#ifndef GL_ALREADY_SIGNALED
+#define GL_ALREADY_SIGNALED 0x911A
+#endif
+#ifndef GL_CONDITION_SATISFIED
+#define GL_CONDITION_SATISFIED 0x911C
+#endif
+#ifndef GL_FRAMEBUFFER
+#define GL_FRAMEBUFFER 0x8D40
+#endif
+#ifndef GL_READ_FRAMEBUFFER
+#define GL_READ_FRAMEBUFFER 0x8CA8
+#endif
+#ifndef GL_DRAW_FRAMEBUFFER
+#define GL_DRAW_FRAMEBUFFER 0x8CA9
+#endif
+#ifndef GL_DRAW_FRAMEBUFFER_BINDING
+#define GL_DRAW_FRAMEBUFFER_BINDING 0x8CA6
+#endif
+#ifndef GL_RENDERBUFFER
+#define GL_RENDERBUFFER 0x8D41
+#endif
+#ifndef GL_COLOR_ATTACHMENT0
+#define GL_COLOR_ATTACHMENT0 0x8CE0
+#endif
+#ifndef GL_DEPTH_ATTACHMENT
+#define GL_DEPTH_ATTACHMENT 0x8D00
+#endif
+#ifndef GL_FRAMEBUFFER_COMPLETE
+#define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+#endif
+#ifndef GL_DEPTH_COMPONENT24
+#define GL_DEPTH_COMPONENT24 0x81A6
+#endif
+
+// Ҫصĺֵ֡
+#define VOXEL_GL_FUNCTIONS(X) \
+    X(void, glGenBuffers, (GLsizei n, GLuint* buffers)) \
+    X(void, glDeleteBuffers, (GLsizei n, const GLuint* buffers)) \
+    X(void, glBindBuffer, (GLenum target, GLuint buffer)) \
+    X(void, glBufferData, (GLenum target, GLsizeiptr size, const void* data, GLenum usage)) \
+    X(void, glBufferSubData, (GLenum target, GLintptr offset, GLsizeiptr size, const void* data)) \
+    X(GLuint, glCreateShader, (GLenum type)) \
+    X(void, glDeleteShader, (GLuint shader)) \
+    X(void, glShaderSource, (GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length)) \
+    X(void, glCompileShader, (GLuint shader)) \
+    X(void, glGetShaderiv, (GLuint shader, GLenum pname, GLint* params)) \
+    X(void, glGetShaderInfoLog, (GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog)) \
+    X(GLuint, glCreateProgram, (void)) \
+    X(void, glAttachShader, (GLuint program, GLuint shader)) \
+    X(void, glBindAttribLocation, (GLuint program, GLuint index, const GLchar* name)) \
+    X(void, glLinkProgram, (GLuint program)) \
+    X(void, glGetProgramiv, (GLuint program, GLenum pname, GLint* params)) \
+    X(void, glGetProgramInfoLog, (GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog)) \
+    X(void, glUseProgram, (GLuint program)) \
+    X(GLint, glGetUniformLocation, (GLuint program, const GLchar* name)) \
+    X(void, glUniform1i, (GLint location, GLint v0)) \
+    X(void, glUniform1f, (GLint location, GLfloat v0)) \
+    X(void, glUniform3f, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2)) \
+    X(void, glUniformMatrix4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)) \
+    X(void, glVertexAttribPointer, (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer)) \
+    X(void, glEnableVertexAttribArray, (GLuint index)) \
+    X(void, glDisableVertexAttribArray, (GLuint index)) \
+    X(void, glVertexAttribDivisor, (GLuint index, GLuint divisor)) \
+    X(void, glDrawArraysInstanced, (GLenum mode, GLint first, GLsizei count, GLsizei instancecount))
+
+// ѡĺGL 3.0 / 3.1 / 3.2ݴ滷ϴãȱʱ˻ glBufferSubDataӰ loadGLExtensions() Ľ
+#define VOXEL_GL_OPTIONAL_FUNCTIONS(X) \
+    X(void*, glMapBufferRange, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)) \
+    X(GLboolean, glUnmapBuffer, (GLenum target)) \
+    X(void, glCopyBufferSubData, (GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size)) \
+    X(GLsync, glFenceSync, (GLenum condition, GLbitfield flags)) \
+    X(GLenum, glClientWaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout)) \
+    X(void, glDeleteSync, (GLsync sync))
+
+// ѡĺGL 3.0ֱ̬ʵĿ죬ȱʱһֱڷֱֱӻ
+#define VOXEL_GL_FRAMEBUFFER_FUNCTIONS(X) \
+    X(void, glGenFramebuffers, (GLsizei n, GLuint* framebuffers)) \
+    X(void, glDeleteFramebuffers, (GLsizei n, const GLuint* framebuffers)) \
+    X(void, glBindFramebuffer, (GLenum target, GLuint framebuffer)) \
+    X(void, glFramebufferRenderbuffer, (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)) \
+    X(GLenum, glCheckFramebufferStatus, (GLenum target)) \
+    X(void, glGenRenderbuffers, (GLsizei n, GLuint* renderbuffers)) \
+    X(void, glDeleteRenderbuffers, (GLsizei n, const GLuint* renderbuffers)) \
+    X(void, glBindRenderbuffer, (GLenum target, GLuint renderbuffer)) \
+    X(void, glRenderbufferStorage, (GLenum target, GLenum internalformat, GLsizei width, GLsizei height)) \
+    X(void, glBlitFramebuffer, (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter))
+
+
+// ָ룬úѱ׼ӳȥճд glGenBuffers(...)
+#define VOXEL_GL_DECLARE(ret, name, params) \
+    typedef ret (APIENTRY* name##_proc) params; \
+    extern name##_proc voxel_##name;
+VOXEL_GL_FUNCTIONS(VOXEL_GL_DECLARE)
+VOXEL_GL_OPTIONAL_FUNCTIONS(VOXEL_GL_DECLARE)
+VOXEL_GL_FRAMEBUFFER_FUNCTIONS(VOXEL_GL_DECLARE)
+#undef VOXEL_GL_DECLARE
+
+#define glGenBuffers voxel_glGenBuffers
+#define glDeleteBuffers voxel_glDeleteBuffers
+#define glBindBuffer voxel_glBindBuffer
+#define glBufferData voxel_glBufferData
+#define glBufferSubData voxel_glBufferSubData
+#define glCreateShader voxel_glCreateShader
+#define glDeleteShader voxel_glDeleteShader
+#define glShaderSource voxel_glShaderSource
+#define glCompileShader voxel_glCompileShader
+#define glGetShaderiv voxel_glGetShaderiv
+#define glGetShaderInfoLog voxel_glGetShaderInfoLog
+#define glCreateProgram voxel_glCreateProgram
+#define glAttachShader voxel_glAttachShader
+#define glBindAttribLocation voxel_glBindAttribLocation
+#define glLinkProgram voxel_glLinkProgram
+#define glGetProgramiv voxel_glGetProgramiv
+#define glGetProgramInfoLog voxel_glGetProgramInfoLog
+#define glUseProgram voxel_glUseProgram
+#define glGetUniformLocation voxel_glGetUniformLocation
+#define glUniform1i voxel_glUniform1i
+#define glUniform1f voxel_glUniform1f
+#define glUniform3f voxel_glUniform3f
+#define glUniformMatrix4fv voxel_glUniformMatrix4fv
+#define glVertexAttribPointer voxel_glVertexAttribPointer
+#define glEnableVertexAttribArray voxel_glEnableVertexAttribArray
+#define glDisableVertexAttribArray voxel_glDisableVertexAttribArray
+#define glVertexAttribDivisor voxel_glVertexAttribDivisor
+#define glDrawArraysInstanced voxel_glDrawArraysInstanced
+#define glMapBufferRange voxel_glMapBufferRange
+#define glUnmapBuffer voxel_glUnmapBuffer
+#define glCopyBufferSubData voxel_glCopyBufferSubData
+#define glFenceSync voxel_glFenceSync
+#define glClientWaitSync voxel_glClientWaitSync
+#define glDeleteSync voxel_glDeleteSync
+#define glGenFramebuffers voxel_glGenFramebuffers
+#define glDeleteFramebuffers voxel_glDeleteFramebuffers
+#define glBindFramebuffer voxel_glBindFramebuffer
+#define glFramebufferRenderbuffer voxel_glFramebufferRenderbuffer
+#define glCheckFramebufferStatus voxel_glCheckFramebufferStatus
+#define glGenRenderbuffers voxel_glGenRenderbuffers
+#define glDeleteRenderbuffers voxel_glDeleteRenderbuffers
+#define glBindRenderbuffer voxel_glBindRenderbuffer
+#define glRenderbufferStorage voxel_glRenderbufferStorage
+#define glBlitFramebuffer voxel_glBlitFramebuffer
+
+// кڴڣGL ģ֮ãȱκһ false
+bool loadGLExtensions();
+
+// ѡǷ񶼼سɹloadGLExtensions() ֮ã
+bool hasStagedUploads();
+
+// ֡ glBlitFramebuffer Ƿ񶼼سɹ
+bool hasFramebuffers();
+
+// 벢ɫattributes  nullptr β˳󶨵 0, 1, 2...
+// ʧʱӡ־ 0
+GLuint buildShaderProgram(const char* vertexSource, const char* fragmentSource, const char* const* attributes);
+
+#endif // GL_EXT_H
\ No newline at end of file
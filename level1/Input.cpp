@@ -0,0 +1,56 @@
+#include "Input.h"
+
+#include <cctype>
+#include <cstring>
+
+InputState::InputState() {
+    releaseAll();
+}
+
+unsigned char InputState::normalize(unsigned char key) {
+    // ס Shift ʱµ 'W'ɿ Shift ̧ 'w'ͳһСдŲῨ
+    return (unsigned char)std::tolower(key);
+}
+
+void InputState::keyDown(unsigned char key, double timeMs) {
+    key = normalize(key);
+    down[key] = true;
+    tapped[key] = true;
+    if (!hasEvent) {
+        hasEvent = true;
+        eventMs = timeMs;
+    }
+}
+
+void InputState::keyUp(unsigned char key, double timeMs) {
+    key = normalize(key);
+    down[key] = false;
+    if (!hasEvent) {
+        hasEvent = true;
+        eventMs = timeMs;
+    }
+}
+
+bool InputState::sample(double& firstEventMs) {
+    for (int k = 0; k < 256; ++k) {
+        snapshot[k] = down[k] || tapped[k];
+        tapped[k] = false;
+    }
+
+    bool had = hasEvent;
+    if (had) firstEventMs = eventMs;
+    hasEvent = false;
+    return had;
+}
+
+bool InputState::held(unsigned char key) const {
+    return snapshot[normalize(key)];
+}
+
+void InputState::releaseAll() {
+    memset(down, 0, sizeof(down));
+    memset(tapped, 0, sizeof(tapped));
+    memset(snapshot, 0, sizeof(snapshot));
+    hasEvent = false;
+    eventMs = 0.0;
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+// ״̬
+// - GLUT İ / ̧صֻ¼״̬¼ʱ䣬ֱƶ
+// - ÿ֡ģ⿪ʼʱ sample() һΣ֮һ֡ͬһݿգ
+//   ƶٶֻ֡йأϵͳİظƵ޹
+// - β֮䰴̧ļ㰴һ֡㰴סᶪ
+class InputState {
+public:
+    InputState();
+
+    // timeMs ǻصõʱ̣steady_clock 룩ڲ뵽ӳ
+    void keyDown(unsigned char key, double timeMs);
+    void keyUp(unsigned char key, double timeMs);
+
+    // ɱ֡գβ֮а¼ʱ true¼ʱ
+    bool sample(double& firstEventMs);
+
+    // ǷסĸִСд
+    bool held(unsigned char key) const;
+
+    // а뿪 / ʧȥ㡢ڱʱãglutEntryFunc / glutWindowStatusFunc
+    void releaseAll();
+
+private:
+    static unsigned char normalize(unsigned char key);
+
+    bool down[256];         // صάʵʱ״̬
+    bool tapped[256];       // ϴβ¹
+    bool snapshot[256];     // ֡
+    bool hasEvent;
+    double eventMs;
+};
+
+#endif // INPUT_H
\ No newline at end of file
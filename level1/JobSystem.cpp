@@ -0,0 +1,283 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// wait() ҲʱóôʱƬܶʱظһ˯߻ѵĴۣ
+static const int WAIT_SPINS = 64;
+
+// ǰ߳ĸĸ
+static thread_local const JobSystem* tlsOwner = nullptr;
+static thread_local int tlsSlot = -1;
+
+JobSystem::JobSystem(int numThreads, bool pinThreads) {
+    if (numThreads < 1) numThreads = 1;
+    for (int i = 0; i < numThreads; ++i) {
+        slots.push_back(std::unique_ptr<Slot>(new Slot()));
+    }
+
+    //  0 ߣ̣߳
+    tlsOwner = this;
+    tlsSlot = 0;
+
+    for (int i = 1; i < numThreads; ++i) {
+        workers.push_back(std::thread(&JobSystem::workerLoop, this, i, pinThreads));
+    }
+}
+
+JobSystem::~JobSystem() {
+    stopping = true;
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        wakeUp.notify_all();
+    }
+    for (auto& t : workers) t.join();
+
+    if (tlsOwner == this) {
+        tlsOwner = nullptr;
+        tlsSlot = -1;
+    }
+}
+
+int JobSystem::hardwareThreads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : (int)n;
+}
+
+bool JobSystem::pinCurrentThread(int core) {
+#ifdef _WIN32
+    DWORD_PTR mask = (DWORD_PTR)1 << (core % (int)(sizeof(DWORD_PTR) * 8));
+    return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core % CPU_SETSIZE, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)core;
+    return false;
+#endif
+}
+
+int JobSystem::currentSlot() const {
+    return tlsOwner == this ? tlsSlot : -1;
+}
+
+TaskHandle JobSystem::submit(std::function<void()> fn, const std::vector<TaskHandle>& deps, int affinity) {
+    TaskHandle task = std::make_shared<Task>();
+    task->fn = std::move(fn);
+    task->affinity = affinity;
+
+    // ǼѾɵֱ
+    for (const auto& dep : deps) {
+        if (!dep) continue;
+        std::lock_guard<std::mutex> guard(dep->lock);
+        if (!dep->done) {
+            task->pending++;
+            dep->continuations.push_back(task);
+        }
+    }
+
+    // ȥύûδɵ
+    if (--task->pending == 0) schedule(task);
+    return task;
+}
+
+void JobSystem::schedule(const TaskHandle& task) {
+    int n = (int)slots.size();
+
+    if (task->affinity >= 0) {
+        Slot& s = *slots[task->affinity % n];
+        {
+            std::lock_guard<std::mutex> guard(s.lock);
+            s.pinned.push_back(task);
+        }
+        s.pinnedCount++;
+        // 뻽ָֻ̣߳ȫ
+        std::lock_guard<std::mutex> guard(sleepLock);
+        wakeUp.notify_all();
+        waitWake.notify_all();
+        return;
+    }
+
+    // ԼŽԼĶβⲿ߳
+    int target = currentSlot();
+    if (target < 0) target = (int)(nextSlot++ % (unsigned)n);
+
+    {
+        Slot& s = *slots[target];
+        std::lock_guard<std::mutex> guard(s.lock);
+        s.tasks.push_back(task);
+    }
+    queued++;
+
+    if (sleeping.load() > 0 || waiting.load() > 0) {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        wakeUp.notify_one();
+        waitWake.notify_all();
+    }
+}
+
+void JobSystem::finish(const TaskHandle& task) {
+    std::vector<TaskHandle> next;
+    {
+        std::lock_guard<std::mutex> guard(task->lock);
+        task->done = true;
+        next.swap(task->continuations);
+    }
+    task->fn = nullptr; // ͷŲ
+
+    // done  waiting ȡwait()  waiting ټ done˳һµԭӲ©
+    if (waiting.load() > 0) {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        waitWake.notify_all();
+    }
+
+    for (const auto& c : next) {
+        if (--c->pending == 0) schedule(c);
+    }
+}
+
+TaskHandle JobSystem::popLocal(int slot) {
+    Slot& s = *slots[slot];
+    std::lock_guard<std::mutex> guard(s.lock);
+
+    if (!s.pinned.empty()) {
+        TaskHandle t = s.pinned.front();
+        s.pinned.pop_front();
+        s.pinnedCount--;
+        return t;
+    }
+    if (!s.tasks.empty()) {
+        TaskHandle t = s.tasks.back();
+        s.tasks.pop_back();
+        queued--;
+        return t;
+    }
+    return nullptr;
+}
+
+TaskHandle JobSystem::steal(int thief) {
+    int n = (int)slots.size();
+    int start = thief < 0 ? 0 : thief + 1;
+
+    for (int i = 0; i < n; ++i) {
+        int victim = (start + i) % n;
+        if (victim == thief) continue;
+
+        Slot& s = *slots[victim];
+        std::lock_guard<std::mutex> guard(s.lock);
+        if (!s.tasks.empty()) {
+            TaskHandle t = s.tasks.front();
+            s.tasks.pop_front();
+            queued--;
+            return t;
+        }
+    }
+    return nullptr;
+}
+
+bool JobSystem::tryRunOne(int slot) {
+    TaskHandle task;
+    if (slot >= 0) task = popLocal(slot);
+    if (!task) task = steal(slot);
+    if (!task) return false;
+
+    task->fn();
+    finish(task);
+    return true;
+}
+
+void JobSystem::wait(const TaskHandle& task) {
+    if (!task) return;
+    int slot = currentSlot();
+    int idle = 0;
+    while (!task->done) {
+        if (tryRunOne(slot)) {
+            idle = 0;
+            continue;
+        }
+        if (++idle < WAIT_SPINS) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::unique_lock<std::mutex> lk(sleepLock);
+        waiting++;
+        waitWake.wait(lk, [&]() {
+            return task->done.load() || queued.load() > 0 ||
+                (slot >= 0 && slots[slot]->pinnedCount.load() > 0);
+        });
+        waiting--;
+        idle = 0;
+    }
+}
+
+void JobSystem::waitAll(const std::vector<TaskHandle>& tasks) {
+    for (const auto& t : tasks) wait(t);
+}
+
+void JobSystem::runPending() {
+    int slot = currentSlot();
+    if (slot < 0) return;
+
+    Slot& s = *slots[slot];
+    while (s.pinnedCount > 0) {
+        TaskHandle task;
+        {
+            std::lock_guard<std::mutex> guard(s.lock);
+            if (s.pinned.empty()) break;
+            task = s.pinned.front();
+            s.pinned.pop_front();
+            s.pinnedCount--;
+        }
+        task->fn();
+        finish(task);
+    }
+}
+
+void JobSystem::parallelFor(int begin, int end, int grain, const std::function<void(int, int)>& body) {
+    int count = end - begin;
+    if (count <= 0) return;
+
+    if (grain <= 0) grain = std::max(1, count / (threadCount() * 4));
+
+    // ֻһֻ̻߳һʱֱڵǰִ߳Уʡȿ
+    if (threadCount() == 1 || count <= grain) {
+        body(begin, end);
+        return;
+    }
+
+    std::vector<TaskHandle> blocks;
+    blocks.reserve((count + grain - 1) / grain);
+    for (int b = begin; b < end; b += grain) {
+        int e = std::min(end, b + grain);
+        blocks.push_back(submit([&body, b, e]() { body(b, e); }));
+    }
+    waitAll(blocks);
+}
+
+void JobSystem::workerLoop(int slot, bool pin) {
+    tlsOwner = this;
+    tlsSlot = slot;
+
+    if (pin) pinCurrentThread(slot);
+
+    Slot& own = *slots[slot];
+    while (!stopping) {
+        if (tryRunOne(slot)) continue;
+
+        std::unique_lock<std::mutex> lk(sleepLock);
+        sleeping++;
+        wakeUp.wait(lk, [&]() {
+            return stopping || queued.load() > 0 || own.pinnedCount.load() > 0;
+        });
+        sleeping--;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// һ +  + ɺҪѵĺ
+struct Task {
+    std::function<void()> fn;
+    std::atomic<int> pending{ 1 };      // δɵ 1 ύ
+    std::atomic<bool> done{ false };
+    int affinity = -1;                  // -1 = ̣߳>=0 = ֻڸִ̲߳
+
+    std::mutex lock;                    //  continuations
+    std::vector<std::shared_ptr<Task>> continuations;
+};
+
+typedef std::shared_ptr<Task> TaskHandle;
+
+// ȡ
+// - ÿ̲߳һ˫˶УԼβȡ (LIFO)˴ͷ͵ (FIFO)
+// -  0 ڴ̣߳ͨ GLUT ֻ̣߳ wait() ʱæɻ
+// - ָ affinity ŽӦ۵˽жУᱻ͵ߣ GL ִ߳е
+class JobSystem {
+public:
+    // numThreads ̱߳pinThreads Ϊ true ʱѹ̰߳󶨵̶ CPU 
+    explicit JobSystem(int numThreads = hardwareThreads(), bool pinThreads = false);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // ύdeps ȫɺŻῪʼִ
+    TaskHandle submit(std::function<void()> fn,
+        const std::vector<TaskHandle>& deps = {}, int affinity = -1);
+
+    // ȴɣȴڼ䵱ǰִ̻߳ / ȡ
+    // ûпʱȶɻӣһֱռһ
+    void wait(const TaskHandle& task);
+    void waitAll(const std::vector<TaskHandle>& tasks);
+
+    //  for [begin, end) гɴСԼΪ grain Ŀ飬body(blockBegin, blockEnd)
+    // grain <= 0 ʱԶ߳з
+    void parallelFor(int begin, int end, int grain, const std::function<void(int, int)>& body);
+
+    // ִеǰ̲߳Ѿ߳ÿ֡һΣ󶨵̵߳
+    void runPending();
+
+    // ڵǰִ߳һѾûʱ false
+    // ̵߳ûй̣߳߳ÿ֡һΣų֮́֡ƽ
+    bool runOne() { return tryRunOne(currentSlot()); }
+
+    int threadCount() const { return (int)slots.size(); }
+
+    // ǰ߳ڱеĲۺţⲿ̷߳ -1
+    int currentSlot() const;
+
+    static int hardwareThreads();
+
+    // ѵ̰߳󶨵ĳ CPU ģʧܷ false
+    static bool pinCurrentThread(int core);
+
+private:
+    struct Slot {
+        std::mutex lock;
+        std::deque<TaskHandle> tasks;   // ɱȡ
+        std::deque<TaskHandle> pinned;  // ֻɱִ
+        std::atomic<int> pinnedCount{ 0 };
+    };
+
+    void schedule(const TaskHandle& task);
+    void finish(const TaskHandle& task);
+    bool tryRunOne(int slot);
+    TaskHandle popLocal(int slot);
+    TaskHandle steal(int thief);
+    void workerLoop(int slot, bool pin);
+
+    std::vector<std::unique_ptr<Slot>> slots;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepLock;
+    std::condition_variable wakeUp;
+    std::condition_variable waitWake;   // wait() ̣߳ɻʱ
+    std::atomic<int> waiting{ 0 };
+    std::atomic<int> queued{ 0 };       // ȡе
+    std::atomic<int> sleeping{ 0 };
+    std::atomic<bool> stopping{ false };
+    std::atomic<unsigned> nextSlot{ 0 };
+};
+
+#endif // JOB_SYSTEM_H
\ No newline at end of file
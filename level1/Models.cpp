@@ -1,11 +1,15 @@
 #include "Models.h"
+#include "BakedModels.h"
+#include "JobSystem.h"
+#include "VoxelFont.h"
 #include <cmath>
 
 // Իģ - ߲ع̬
 // Իģ - 棺ִˣ´ֱ
 // Իģ - վް棺° + ٣īǡڡü
-std::vector<Voxel> createSelfPortraitModel() {
-    std::vector<Voxel> model;
+// [決] ʱΪ constexprڱ
+constexpr BakeTable<Voxel, 4096> bakeSelfPortrait() {
+    BakeTable<Voxel, 4096> model;
 
     // --- ɫ ---
     const float SKIN_R = 0.9f, SKIN_G = 0.7f, SKIN_B = 0.5f;
@@ -22,80 +26,80 @@ std::vector<Voxel> createSelfPortraitModel() {
     // ==================== ° (״̬) ====================
 
     // --- Ь ---
-    model.push_back({ -1.7f, 0.0f, 0.0f, SHOES_R, SHOES_G, SHOES_B });
-    model.push_back({ -1.3f, 0.0f, 0.0f, SHOES_R, SHOES_G, SHOES_B });
-    model.push_back({ -1.5f, 0.0f, 1.0f, SHOES_R, SHOES_G, SHOES_B });
-    model.push_back({ -1.7f, 0.0f, 1.0f, SHOES_R, SHOES_G, SHOES_B });
-    model.push_back({ -1.3f, 0.0f, 1.0f, SHOES_R, SHOES_G, SHOES_B });
-    model.push_back({ -1.5f, 0.0f, 1.0f, SHOES_R, SHOES_G, SHOES_B });
-    model.push_back({ 1.7f, 0.0f, 0.0f, SHOES_R, SHOES_G, SHOES_B });
-    model.push_back({ 1.3f, 0.0f, 0.0f, SHOES_R, SHOES_G, SHOES_B });
-    model.push_back({ 1.5f, 0.0f, 1.0f, SHOES_R, SHOES_G, SHOES_B });
-    model.push_back({ 1.7f, 0.0f, 1.0f, SHOES_R, SHOES_G, SHOES_B });
-    model.push_back({ 1.3f, 0.0f, 1.0f, SHOES_R, SHOES_G, SHOES_B });
-    model.push_back({ 1.5f, 0.0f, 1.0f, SHOES_R, SHOES_G, SHOES_B });
+    model.add(-1.7f, 0.0f, 0.0f, SHOES_R, SHOES_G, SHOES_B);
+    model.add(-1.3f, 0.0f, 0.0f, SHOES_R, SHOES_G, SHOES_B);
+    model.add(-1.5f, 0.0f, 1.0f, SHOES_R, SHOES_G, SHOES_B);
+    model.add(-1.7f, 0.0f, 1.0f, SHOES_R, SHOES_G, SHOES_B);
+    model.add(-1.3f, 0.0f, 1.0f, SHOES_R, SHOES_G, SHOES_B);
+    model.add(-1.5f, 0.0f, 1.0f, SHOES_R, SHOES_G, SHOES_B);
+    model.add(1.7f, 0.0f, 0.0f, SHOES_R, SHOES_G, SHOES_B);
+    model.add(1.3f, 0.0f, 0.0f, SHOES_R, SHOES_G, SHOES_B);
+    model.add(1.5f, 0.0f, 1.0f, SHOES_R, SHOES_G, SHOES_B);
+    model.add(1.7f, 0.0f, 1.0f, SHOES_R, SHOES_G, SHOES_B);
+    model.add(1.3f, 0.0f, 1.0f, SHOES_R, SHOES_G, SHOES_B);
+    model.add(1.5f, 0.0f, 1.0f, SHOES_R, SHOES_G, SHOES_B);
 
     // --- Ȳ ---
     for (int y = 1; y <= 3; ++y) {
-        model.push_back({ -1.5f, (float)y, 0.0f, SKIN_R, SKIN_G, SKIN_B });
-        model.push_back({ 1.5f, (float)y, 0.0f, SKIN_R, SKIN_G, SKIN_B });
+        model.add(-1.5f, (float)y, 0.0f, SKIN_R, SKIN_G, SKIN_B);
+        model.add(1.5f, (float)y, 0.0f, SKIN_R, SKIN_G, SKIN_B);
     }
 
     // --- ̿ (ȷ϶) ---
     // 
     for (float x = -bodyWidth / 2; x <= bodyWidth / 2; ++x) {
         for (float z = -bodyDepth / 2; z <= bodyDepth / 2; ++z) {
-            model.push_back({ x, 5.0f, z, PANTS_R, PANTS_G, PANTS_B });
+            model.add(x, 5.0f, z, PANTS_R, PANTS_G, PANTS_B);
         }
     }
     // 
     float innerPos = 0.35f + 0.5f;
     for (float z = -bodyDepth / 2; z <= bodyDepth / 2; ++z) {
-        model.push_back({ -1.5f, 4.0f, z, PANTS_R, PANTS_G, PANTS_B });
-        model.push_back({ -innerPos, 4.0f, z, PANTS_R, PANTS_G, PANTS_B });
-        model.push_back({ 1.5f, 4.0f, z, PANTS_R, PANTS_G, PANTS_B });
-        model.push_back({ innerPos, 4.0f, z, PANTS_R, PANTS_G, PANTS_B });
+        model.add(-1.5f, 4.0f, z, PANTS_R, PANTS_G, PANTS_B);
+        model.add(-innerPos, 4.0f, z, PANTS_R, PANTS_G, PANTS_B);
+        model.add(1.5f, 4.0f, z, PANTS_R, PANTS_G, PANTS_B);
+        model.add(innerPos, 4.0f, z, PANTS_R, PANTS_G, PANTS_B);
     }
 
     // ---  ---
     for (int y = 6; y <= 9; ++y) {
         for (float x = -bodyWidth / 2; x <= bodyWidth / 2; ++x) {
             for (float z = -bodyDepth / 2; z <= bodyDepth / 2; ++z) {
-                model.push_back({ x, (float)y, z, SHIRT_R, SHIRT_G, SHIRT_B });
+                model.add(x, (float)y, z, SHIRT_R, SHIRT_G, SHIRT_B);
             }
         }
     }
 
     // --- ֱ ---
     //  ()
-    model.push_back({ 2.5f, 8.0f, 0.0f, SHIRT_R, SHIRT_G, SHIRT_B });
+    model.add(2.5f, 8.0f, 0.0f, SHIRT_R, SHIRT_G, SHIRT_B);
     for (float y = 4.7f; y <= 7.0f; y+=0.1f) {
-        model.push_back({ 2.5f, (float)y, 0.0f, SKIN_R, SKIN_G, SKIN_B });
+        model.add(2.5f, (float)y, 0.0f, SKIN_R, SKIN_G, SKIN_B);
     }
     // ұ (´)
-    model.push_back({ -2.5f, 8.0f, 0.0f, SHIRT_R, SHIRT_G, SHIRT_B });
+    model.add(-2.5f, 8.0f, 0.0f, SHIRT_R, SHIRT_G, SHIRT_B);
     // --- ұϲ (ƽɰ) ---
     // ԭ뷶ΧY  7.0  6.2Z  -0.1  -0.9
     // ڸѭܶ10ʵ˿Ч
     for (int i = 0; i <= 800; ++i) {
         float offset = (float)i * 0.001f; // ÿ 0.01 ƫ
 
-        model.push_back({
+        model.add(
             -2.5f,              // X ֲ
             7.0f - offset*0.9f,      // Y 𽥼 0.01 ( 7.0  6.2)
             -0.0f - offset*1.4f,     // Z 𽥼 0.01 ( -0.1  -0.9)
             SKIN_R, SKIN_G, SKIN_B
-            });
+            );
     }
     for (int i = 0; i <= 700; ++i) {
         float offset = (float)i * 0.001f;
 
-        model.push_back({
+        model.add(
             -2.5f,              // X ֲ
             6.28f - offset*1.7f,      // Y 𽥼 ( 6.0  5.3)
             -1.12f + offset,     // Z  ( -0.7 ص 0.0)
             SKIN_R, SKIN_G, SKIN_B
-            });
+            );
     }
 
     // ==================== ͷ (ȫ) ====================
@@ -105,14 +109,14 @@ std::vector<Voxel> createSelfPortraitModel() {
     for (int y = 10; y <= 12; ++y) {
         for (int x = -1; x <= 1; ++x) {
             for (int z = -1; z <= 1; ++z) {
-                model.push_back({ (float)x, (float)y, (float)z, SKIN_R, SKIN_G, SKIN_B });
+                model.add((float)x, (float)y, (float)z, SKIN_R, SKIN_G, SKIN_B);
             }
         }
     }
     // ͷ (Y=13 )
     for (float x = -1.225f; x <= 1.225f; x+=0.025f) {
         for (float z = -1.05f; z <= 1.5f; z+=0.225f) {
-            model.push_back({ (float)x, 13.0f, (float)z, HAIR_R, HAIR_G, HAIR_B });
+            model.add((float)x, 13.0f, (float)z, HAIR_R, HAIR_G, HAIR_B);
         }
     }
 
@@ -120,8 +124,8 @@ std::vector<Voxel> createSelfPortraitModel() {
     // ͷ󲿱 Z = -1.5
     // ǰͷ Z = -1.6պں棬˸
     for (float x = -1.225f; x <= 1.225f; x += 0.025f) {
-        model.push_back({ (float)x, 12.4f, -1.05f, HAIR_R, HAIR_G, HAIR_B });
-        //model.push_back({ (float)x, 12.0f, -1.3f, HAIR_R, HAIR_G, HAIR_B }); // ӳͷ
+        model.add((float)x, 12.4f, -1.05f, HAIR_R, HAIR_G, HAIR_B);
+        //model.add((float)x, 12.0f, -1.3f, HAIR_R, HAIR_G, HAIR_B); // ӳͷ
     }
 
 
@@ -129,9 +133,9 @@ std::vector<Voxel> createSelfPortraitModel() {
 }
 
 
-//  createWatchModel 
-std::vector<VoxelWatch> createWatchModel() {
-    std::vector<VoxelWatch> watchModel;
+// ֱģͺͬڱɣ
+constexpr BakeTable<VoxelWatch, 64> bakeWatch() {
+    BakeTable<VoxelWatch, 64> watchModel;
 
     // ֱ۲ X=2.5, Y=6.0, Z=0.0 ߴ 1.0
     // ֱɫ
@@ -141,38 +145,63 @@ std::vector<VoxelWatch> createWatchModel() {
     // 1.  -  (Z > 0.5)
     //  Z=0.55 һС
     for (float x = 2.1f; x <= 2.9f; x += 0.2f) {
-        watchModel.push_back({ x, 5.1f, 0.55f, BAND_R, BAND_G, BAND_B });
+        watchModel.add(x, 5.1f, 0.55f, BAND_R, BAND_G, BAND_B);
     }
 
     // 2.  -  (Z < -0.5)
     //  Z=-0.55 һ
     for (float x = 2.1f; x <= 2.9f; x += 0.2f) {
-        watchModel.push_back({ x, 5.1f, -0.55f, BAND_R, BAND_G, BAND_B });
+        watchModel.add(x, 5.1f, -0.55f, BAND_R, BAND_G, BAND_B);
     }
 
     // 3.  -  (X > 3.0)
     //  X=3.05 һ
     for (float z = -0.5f; z <= 0.5f; z += 0.2f) {
-        watchModel.push_back({ 3.05f, 5.1f, z, BAND_R, BAND_G, BAND_B });
+        watchModel.add(3.05f, 5.1f, z, BAND_R, BAND_G, BAND_B);
     }
 
     // 4.  - ڲ (X < 2.0)
     //  X=1.95 һ
     for (float z = -0.5f; z <= 0.5f; z += 0.2f) {
-        watchModel.push_back({ 1.95f, 5.1f, z, BAND_R, BAND_G, BAND_B });
+        watchModel.add(1.95f, 5.1f, z, BAND_R, BAND_G, BAND_B);
     }
 
     // 5.  (΢ͻһ㣬Z=0.65)
     // ƫλã
-    watchModel.push_back({ 2.5f, 5.1f, 0.65f, FACE_R, FACE_G, FACE_B });       // 
-    watchModel.push_back({ 2.5f + 0.2f, 5.1f, 0.65f, BAND_R, BAND_G, BAND_B }); // װαԵ
-    watchModel.push_back({ 2.5f - 0.2f, 5.1f, 0.65f, BAND_R, BAND_G, BAND_B }); // װαԵ
+    watchModel.add(2.5f, 5.1f, 0.65f, FACE_R, FACE_G, FACE_B);       // 
+    watchModel.add(2.5f + 0.2f, 5.1f, 0.65f, BAND_R, BAND_G, BAND_B); // װαԵ
+    watchModel.add(2.5f - 0.2f, 5.1f, 0.65f, BAND_R, BAND_G, BAND_B); // װαԵ
 
     return watchModel;
 }
 
+// ɡȥغ޳ֱӷŽֻݶ
+// ɵһȥ޳ֵɵҲȥ
+constexpr auto SELF_PORTRAIT_RAW = bakeSelfPortrait();
+constexpr auto WATCH_RAW = bakeWatch();
+constexpr auto SELF_PORTRAIT_TABLE = bakeDedupAndCull(SELF_PORTRAIT_RAW, 1.0f);
+constexpr auto WATCH_TABLE = bakeDedupAndCull(WATCH_RAW, 0.2f);
+
+constexpr std::array<Voxel, SELF_PORTRAIT_TABLE.count> BAKED_SELF_PORTRAIT =
+    bakeShrink<SELF_PORTRAIT_TABLE.count>(SELF_PORTRAIT_TABLE);
+constexpr std::array<VoxelWatch, WATCH_TABLE.count> BAKED_WATCH =
+    bakeShrink<WATCH_TABLE.count>(WATCH_TABLE);
+
+// ģ͸Ķʱʧܣȷı仯
+static_assert(BAKED_SELF_PORTRAIT.size() == 2916, "self portrait voxel count changed");
+static_assert(BAKED_WATCH.size() == 25, "watch voxel count changed");
+
+VoxelSpan<Voxel> bakedSelfPortraitModel() {
+    return { BAKED_SELF_PORTRAIT.data(), BAKED_SELF_PORTRAIT.size() };
+}
+
+VoxelSpan<VoxelWatch> bakedWatchModel() {
+    return { BAKED_WATCH.data(), BAKED_WATCH.size() };
+}
+
 // Ż棺Ȼˮ׵ѩɽ + ջ
-std::vector<Voxel> createLandscapeModel() {
+// ߴ硢߶ȺɫֲĲ scene.txt  [landscape]Ĭֵԭд
+std::vector<Voxel> createLandscapeModel(const LandscapeDesc& desc, JobSystem* jobs) {
     std::vector<Voxel> model;
 
     // ɫ
@@ -183,25 +212,25 @@ std::vector<Voxel> createLandscapeModel() {
 
     // 1. --- ľջ ---
     // 沿
-    for (int x = -50; x <= 50; ++x) {
-        for (int z = -5; z <= 15; ++z) {
-            model.push_back({ (float)x, -1.0f, (float)z, WOOD_R, WOOD_G, WOOD_B });
+    for (int x = desc.walkX0; x <= desc.walkX1; ++x) {
+        for (int z = desc.walkZ0; z <= desc.walkZ1; ++z) {
+            model.push_back({ (float)x, desc.walkY, (float)z, WOOD_R, WOOD_G, WOOD_B });
         }
     }
 
     // 2. ---  (ȫ) ---
     // ѭһӣֻ
 
-    // (1) ֣ᴩջ ( X=-20  X=20)
-    for (int x = -50; x <= 50; ++x) {
-        model.push_back({ (float)x, 5.0f, -4.0f, WOOD_R, WOOD_G, WOOD_B });
+    // (1) ֣ᴩջ
+    for (int x = desc.walkX0; x <= desc.walkX1; ++x) {
+        model.push_back({ (float)x, desc.railY, desc.railZ, WOOD_R, WOOD_G, WOOD_B });
     }
 
-    // (2) ֱÿ 10 λһӣȹ
-    for (int x = -50; x <= 50; x += 10) {
-        // ÿӴ Y=0  Y=4
-        for (int y = 0; y <= 4; ++y) {
-            model.push_back({ (float)x, (float)y, -4.0f, WOOD_R, WOOD_G, WOOD_B });
+    // (2) ֱÿ postSpacing λһӣȹ
+    for (int x = desc.walkX0; x <= desc.walkX1; x += desc.postSpacing) {
+        // ÿӴ Y=0 
+        for (int y = 0; y < desc.railY; ++y) {
+            model.push_back({ (float)x, (float)y, desc.railZ, WOOD_R, WOOD_G, WOOD_B });
         }
     }
 
@@ -209,193 +238,123 @@ std::vector<Voxel> createLandscapeModel() {
 
     // [޸ĵ1] Զ Z=-25 ʼ -15ˮ
     // [޸ĵ2] Χ -60ɽԶ
-    for (int x = -50; x <= 50; ++x) {
-        for (int z = -60; z <= -25; ++z) {
-
-            // [޸ĵ3] ѹ͸߶ȣ
-            // ߶ȽͣҲϵ 8.0  6.0ɽƲôͻأ
-            float distanceFactor = (float)(abs(z) - 25) * 0.4f;
-            float height = 2.0f + distanceFactor +
-                6.0f * sin((float)x * 0.1f) +
-                3.0f * cos((float)z * 0.15f);
-
-            // ĸ߶ȱˮ滹ͣȫˮף
-            // ˮ -2.5 
-            if (height < -3.0f) continue;
-
-            // [޸ĵ4] 
-            // ǿƴ Y=-10 (ˮ) ʼһֱɽ
-            // ɽײͱˮԲƮڿ
-            for (int y = -10; y < height; ++y) {
-                float r, g, b;
-
-                // ɫֲ߼
-                if (y < 5) {
-                    r = GRASS_R; g = GRASS_G; b = GRASS_B; // ɭ֣ڰˮµɽ
-                }
-                else if (y < 12) {
-                    r = ROCK_R; g = ROCK_G; b = ROCK_B;    // ʯ
-                }
-                else {
-                    r = SNOW_R; g = SNOW_G; b = SNOW_B;    // ѩ
-                }
-
-                // Żֻõı棨ɽ3㣬ˮϵĲ֣
-                // 뱣֤ˮ洦з飬ȻῴˮĿն
-                if (y > height - 3.0f || y > -4.0f) {
-                    model.push_back({ (float)x, (float)y, (float)z, r, g, b });
+    // ÿһ X дԼ vector X ˳ƴӣ봮аȫһ
+    std::vector<std::vector<Voxel>> columns(desc.walkX1 - desc.walkX0 + 1);
+    auto buildColumns = [&](int xBegin, int xEnd) {
+        for (int x = xBegin; x < xEnd; ++x) {
+            std::vector<Voxel>& column = columns[x - desc.walkX0];
+            for (int z = desc.mountainZ0; z <= desc.mountainZ1; ++z) {
+
+                // [޸ĵ3] ѹ͸߶ȣ
+                // ߶ȽͣҲϵ 8.0  6.0ɽƲôͻأ
+                float distanceFactor = (float)(abs(z) - abs(desc.mountainZ1)) * desc.mountainSlope;
+                float height = desc.mountainBase + distanceFactor +
+                    desc.mountainSin * sin((float)x * 0.1f) +
+                    desc.mountainCos * cos((float)z * 0.15f);
+
+                // ĸ߶ȱˮ滹ͣȫˮף
+                // ˮ -2.5 
+                if (height < -3.0f) continue;
+
+                // [޸ĵ4] 
+                // ǿƴ Y=-10 (ˮ) ʼһֱɽ
+                // ɽײͱˮԲƮڿ
+                for (int y = -10; y < height; ++y) {
+                    float r, g, b;
+
+                    // ɫֲ߼
+                    if (y < desc.rockLine) {
+                        r = GRASS_R; g = GRASS_G; b = GRASS_B; // ɭ֣ڰˮµɽ
+                    }
+                    else if (y < desc.snowLine) {
+                        r = ROCK_R; g = ROCK_G; b = ROCK_B;    // ʯ
+                    }
+                    else {
+                        r = SNOW_R; g = SNOW_G; b = SNOW_B;    // ѩ
+                    }
+
+                    // Żֻõı棨ɽ3㣬ˮϵĲ֣
+                    // 뱣֤ˮ洦з飬ȻῴˮĿն
+                    if (y > height - 3.0f || y > -4.0f) {
+                        column.push_back({ (float)x, (float)y, (float)z, r, g, b });
+                    }
                 }
             }
         }
+    };
+
+    if (jobs) {
+        jobs->parallelFor(desc.walkX0, desc.walkX1 + 1, 4, buildColumns);
+    }
+    else {
+        buildColumns(desc.walkX0, desc.walkX1 + 1);
+    }
+
+    size_t total = model.size();
+    for (const auto& column : columns) total += column.size();
+    model.reserve(total);
+    for (const auto& column : columns) {
+        model.insert(model.end(), column.begin(), column.end());
     }
 
     return model;
 }
 
-// [] ̬ˮƺ
-// ע⣺vectorֱӵUtils.hdrawCube
-// ÿһ֡Ը time ıλãҪɰ
+// [] ̬ˮ
+// ÿһ֡ time ¼ˮ淽λãֻǧ飬Ҫ
 #include "Utils.h" // ȷdrawCube
-void drawAnimatedWater(float time) {
+// ˮ沨˸߶ȣλ = sin(x + ʱ) + cos(z + ʱ)
+// ע⣺VoxelRenderer ʵɫͬĹʽ޸ʱһ
+float waterWaveHeight(float x, float z, float time) {
+    return sin(x * 0.5f + time * 2.0f) * 0.25f +
+        cos(z * 0.3f + time * 1.5f) * 0.25f;
+}
+
+std::vector<Voxel> createWaterSurface() {
+    std::vector<Voxel> water;
+    water.reserve(101 * 25);
+
     const float WATER_R = 0.2f, WATER_G = 0.6f, WATER_B = 0.9f;
 
-    // ˮ淶Χ
+    // ˮ淶Χ߶ -2.5 (ջ·)
     for (int x = -50; x <= 50; ++x) {
         for (int z = -30; z <= -6; ++z) {
-
-            // Ĳ㷨λ = sin(x + ʱ) + cos(z + ʱ)
-            // ˮͻʱ
-            float waveHeight = sin((float)x * 0.5f + time * 2.0f) * 0.25f +
-                cos((float)z * 0.3f + time * 1.5f) * 0.25f;
-
-            // ߶ -2.0 (ջ·)ϲ˸߶
-            float y = -2.5f + waveHeight;
-
-            // Ʒ
-            drawCube((float)x, y, (float)z, 1.0f, WATER_R, WATER_G, WATER_B);
+            water.push_back({ (float)x, -2.5f, (float)z, WATER_R, WATER_G, WATER_B });
         }
     }
+    return water;
 }
 
-// [Ż] ϸģ (ͽ + ȥ)
-std::vector<VoxelName> createDetailedNameModel() {
-    std::vector<VoxelName> model;
+std::vector<Voxel> createWaterModel(float time) {
+    std::vector<Voxel> water = createWaterSurface();
 
-    float z_base = 8.0f;
-    float voxel_size = 0.25f;
-    float thickness = 0.5f;
-
-    // ӣ
-    // ںѭﶼԣ򵥴
-
-    auto addVoxel = [&](float x, float y, float z, float r, float g, float b, float height_max) {
-
-        // --- Ż 1: ữ䷶Χ ---
-        // ֮ǰ 0.3 -> 1.0 (0.7̫ˣ¶ϲ)
-        // ڸΪ 0.65 -> 1.05 (0.4º)
-        // 㷽ɫСоͻ
-        float h_factor = 1.0f + 0.6f * (y / height_max);
-
-        // --- Ż 2: Ƚ΢ ---
-        // ò治Ҫ̫ڣһͨ͸
-        float d_factor = 0.5f + 0.5f * ((z - z_base) / thickness);
-
-        // --- Ż 3: ؼӡ (Dithering) ---
-        // һ -0.03  +0.03 ֮΢С
-        // ĺƣñ濴пеĥɰʣǽ
-        float noise = ((rand() % 100) / 100.0f - 0.5f) * 0.06f;
-
-        // 
-        float final_factor = h_factor * d_factor + noise;
-
-        float final_r = r * final_factor;
-        float final_g = g * final_factor;
-        float final_b = b * final_factor;
-
-        // 򵥵ɫӳ䣬
-        final_r = sqrt(final_r);
-        final_g = sqrt(final_g);
-        final_b = sqrt(final_b);
-
-        // ֹɫ (Clamp)
-        if (final_r > 1.0f) final_r = 1.0f;
-        if (final_g > 1.0f) final_g = 1.0f;
-        if (final_b > 1.0f) final_b = 1.0f;
-        // ֹɫ
-        if (final_r < 0.0f) final_r = 0.0f;
-        if (final_g < 0.0f) final_g = 0.0f;
-        if (final_b < 0.0f) final_b = 0.0f;
-
-        model.push_back({ x, y, z, final_r, final_g, final_b });
-        };
-
-    // ... ( L, Y, T ѭɴ뱣ֲ䣬ҪĶ) ...
-    // --- 1. ĸ L (Ƽ / Cyan Blue) ---
-    float l_center_x = -17.0f;
-    float l_r = 0.0f, l_g = 0.6f, l_b = 1.0f;
-
-    // L 
-    for (float x = l_center_x - 0.5f; x <= l_center_x + 0.5f; x += voxel_size) {
-        for (float y = 0.0f; y <= 5.0f; y += voxel_size) {
-            for (float z = z_base; z <= z_base + thickness; z += voxel_size) {
-                addVoxel(x, y, z, l_r, l_g, l_b, 5.0f);
-            }
-        }
-    }
-    // L 
-    for (float x = l_center_x + 0.5f; x <= l_center_x + 2.5f; x += voxel_size) {
-        for (float y = 0.0f; y <= 1.0f; y += voxel_size) {
-            for (float z = z_base; z <= z_base + thickness; z += voxel_size) {
-                addVoxel(x, y, z, l_r, l_g, l_b, 5.0f);
-            }
-        }
+    // ϲ˸߶ȣˮͻʱ
+    for (auto& w : water) {
+        w.y += waterWaveHeight(w.x, w.z, time);
     }
-
-    // --- 2. ĸ Y (޺ / Neon Purple) ---
-    float y_center_x = -12.0f;
-    float y_r = 0.8f, y_g = 0.0f, y_b = 1.0f;
-
-    // Y °벿
-    for (float x = y_center_x - 0.5f; x <= y_center_x + 0.5f; x += voxel_size) {
-        for (float y = 0.0f; y <= 2.5f; y += voxel_size) {
-            for (float z = z_base; z <= z_base + thickness; z += voxel_size) {
-                addVoxel(x, y, z, y_r, y_g, y_b, 5.0f);
-            }
-        }
-    }
-    // Y ϰ벿 V 
-    for (float y = 2.5f; y <= 5.0f; y += voxel_size) {
-        float offset = (y - 2.5f) * 0.6f;
-        for (float x = y_center_x - 0.5f - offset; x <= y_center_x + 0.5f - offset; x += voxel_size) {
-            for (float z = z_base; z <= z_base + thickness; z += voxel_size) {
-                addVoxel(x, y, z, y_r, y_g, y_b, 5.0f);
-            }
-        }
-        for (float x = y_center_x - 0.5f + offset; x <= y_center_x + 0.5f + offset; x += voxel_size) {
-            for (float z = z_base; z <= z_base + thickness; z += voxel_size) {
-                addVoxel(x, y, z, y_r, y_g, y_b, 5.0f);
-            }
-        }
+    return water;
+}
+void drawAnimatedWater(float time) {
+    // Ʒ
+    for (const auto& w : createWaterModel(time)) {
+        drawCube(w.x, w.y, w.z, 1.0f, w.r, w.g, w.b);
     }
+}
 
-    // --- 3. ĸ T ( / Hot Orange) ---
-    float t_center_x = -7.0f;
-    float t_r = 1.0f, t_g = 0.5f, t_b = 0.0f;
+// [Ż] ϸģ (ͽ + ȥ)
+//  VoxelFont Ļ棬ֻĸλúͻչdrawCubeȾײã
+std::vector<VoxelName> createDetailedNameModel(const NameDesc& desc) {
+    std::vector<VoxelName> model;
 
-    // T 
-    for (float x = t_center_x - 0.5f; x <= t_center_x + 0.5f; x += voxel_size) {
-        for (float y = 0.0f; y <= 4.0f; y += voxel_size) {
-            for (float z = z_base; z <= z_base + thickness; z += voxel_size) {
-                addVoxel(x, y, z, t_r, t_g, t_b, 5.0f);
-            }
-        }
-    }
-    // T 
-    for (float x = t_center_x - 2.0f; x <= t_center_x + 2.0f; x += voxel_size) {
-        for (float y = 4.0f; y <= 5.0f; y += voxel_size) {
-            for (float z = z_base; z <= z_base + thickness; z += voxel_size) {
-                addVoxel(x, y, z, t_r, t_g, t_b, 5.0f);
-            }
+    for (const NameLetter& letter : desc.letters) {
+        const VoxelGlyph* glyph = voxelGlyph(letter.ch);
+        if (!glyph) continue;
+        const float base[3] = { letter.r, letter.g, letter.b };
+        for (const GlyphVoxel& v : glyph->voxels) {
+            float x = letter.x + v.x, y = v.y, z = desc.z + v.z;
+            float rgb[3];
+            glyphShade(base, x, y, z, v.z, rgb);
+            model.push_back({ x, y, z, rgb[0], rgb[1], rgb[2] });
         }
     }
 
@@ -403,21 +362,20 @@ std::vector<VoxelName> createDetailedNameModel() {
 }
 
 // [] ϸϸ (ü + ī)
-std::vector<VoxelFace> createFaceDetails(float time) {
-    std::vector<VoxelFace> face;
-
-    // ɫ
-    float GLASS_R = 0.1f, GLASS_G = 0.1f, GLASS_B = 0.1f;
-    float SKIN_R = 0.9f, SKIN_G = 0.7f, SKIN_B = 0.5f;
-    float LIP_R = 0.8f, LIP_G = 0.4f, LIP_B = 0.4f;
-    float HAIR_R = 0.15f, HAIR_G = 0.15f, HAIR_B = 0.15f;
-    // [ɫ] ɫ
-    float GLINT_R = 0.9f, GLINT_G = 0.9f, GLINT_B = 0.9f;
-
-    float Z_SURFACE = 1.6f;
-    float Z_POP = 1.7f;
-
-    // 1. ϸī
+// ɫ
+static const float GLASS_R = 0.1f, GLASS_G = 0.1f, GLASS_B = 0.1f;
+static const float FACE_SKIN_R = 0.9f, FACE_SKIN_G = 0.7f, FACE_SKIN_B = 0.5f;
+static const float LIP_R = 0.8f, LIP_G = 0.4f, LIP_B = 0.4f;
+static const float FACE_HAIR_R = 0.15f, FACE_HAIR_G = 0.15f, FACE_HAIR_B = 0.15f;
+// [ɫ] ɫ
+static const float GLINT_R = 0.9f, GLINT_G = 0.9f, GLINT_B = 0.9f;
+
+static const float Z_SURFACE = 1.6f;
+static const float Z_POP = 1.7f;
+static const float GLINT_Y = 11.1f;
+
+// 1. ϸī
+static void addFaceGlasses(std::vector<VoxelFace>& face) {
     // Ƭ (ֲ)
     for (float x = -1.3f; x <= -0.2f; x += 0.25f) {
         for (float y = 10.8f; y <= 11.3f; y += 0.25f) {
@@ -434,80 +392,110 @@ std::vector<VoxelFace> createFaceDetails(float time) {
         face.push_back({ -1.6f, 11.2f, z, GLASS_R, GLASS_G, GLASS_B });
         face.push_back({ 1.6f, 11.2f, z, GLASS_R, GLASS_G, GLASS_B });
     }
+}
 
-    // ***  1: ī (Scanner Effect) ***
-    // һ (-1.3) ɨ (1.3)
-    // fmod ѭٶΪ 2.0
-    float scanPos = -1.5f + fmod(time * 2.5f, 3.5f);
-
-    // ھƬΧڣͻ
-    // ƬΧ
-    if (scanPos >= -1.3f && scanPos <= -0.2f) {
-        face.push_back({ scanPos, 11.1f, Z_POP + 0.05f, GLINT_R, GLINT_G, GLINT_B });
-    }
-    // ҾƬΧ
-    if (scanPos >= 0.2f && scanPos <= 1.3f) {
-        face.push_back({ scanPos, 11.1f, Z_POP + 0.05f, GLINT_R, GLINT_G, GLINT_B });
-    }
-
-
-    // 2.  & 3.  (ֲ)
-    face.push_back({ -0.1f, 10.5f, Z_POP, SKIN_R, SKIN_G, SKIN_B });
-    face.push_back({ 0.1f, 10.5f, Z_POP, SKIN_R, SKIN_G, SKIN_B });
-    face.push_back({ -0.1f, 10.3f, Z_POP, SKIN_R, SKIN_G, SKIN_B });
-    face.push_back({ 0.1f, 10.3f, Z_POP, SKIN_R, SKIN_G, SKIN_B });
+// 2.  & 3.  (ֲ)
+static void addFaceNoseAndMouth(std::vector<VoxelFace>& face) {
+    face.push_back({ -0.1f, 10.5f, Z_POP, FACE_SKIN_R, FACE_SKIN_G, FACE_SKIN_B });
+    face.push_back({ 0.1f, 10.5f, Z_POP, FACE_SKIN_R, FACE_SKIN_G, FACE_SKIN_B });
+    face.push_back({ -0.1f, 10.3f, Z_POP, FACE_SKIN_R, FACE_SKIN_G, FACE_SKIN_B });
+    face.push_back({ 0.1f, 10.3f, Z_POP, FACE_SKIN_R, FACE_SKIN_G, FACE_SKIN_B });
 
     for (float x = -0.3f; x <= 0.3f; x += 0.2f) {
         face.push_back({ x, 9.8f, Z_SURFACE, LIP_R, LIP_G, LIP_B });
     }
+}
 
-    // ***  2: ü (Eyebrow Raise) ***
-    // ʹ sin ƫ
-    // sin(time * 5.0)  -1  1 Ĳ
-    // * 0.15f Ʋȣüëɳ
-    // abs() ȷüëֻѹ
-    float browOffset = abs(sin(time * 4.0f)) * 0.2f;
-
-    // 4. üë (Y˶ƫ)
+// 4. üë (Y϶ƫ)
+static void addFaceBrows(std::vector<VoxelFace>& face, float browOffset) {
     for (float x = -0.9f; x <= -0.2f; x += 0.2f) {
-        face.push_back({ x, 11.8f + browOffset, Z_SURFACE, HAIR_R, HAIR_G, HAIR_B });
+        face.push_back({ x, 11.8f + browOffset, Z_SURFACE, FACE_HAIR_R, FACE_HAIR_G, FACE_HAIR_B });
     }
     for (float x = 0.2f; x <= 0.9f; x += 0.2f) {
-        face.push_back({ x, 11.8f + browOffset, Z_SURFACE, HAIR_R, HAIR_G, HAIR_B });
+        face.push_back({ x, 11.8f + browOffset, Z_SURFACE, FACE_HAIR_R, FACE_HAIR_G, FACE_HAIR_B });
     }
+}
 
-    // 5.  & ޽ (ֲ)
-    face.push_back({ -1.6f, 10.7f, 0.0f, SKIN_R, SKIN_G, SKIN_B });
-    face.push_back({ -1.6f, 10.9f, 0.0f, SKIN_R, SKIN_G, SKIN_B });
-    face.push_back({ 1.6f, 10.7f, 0.0f, SKIN_R, SKIN_G, SKIN_B });
-    face.push_back({ 1.6f, 10.9f, 0.0f, SKIN_R, SKIN_G, SKIN_B });
+// 5.  & ޽ (ֲ)
+static void addFaceEarsAndHair(std::vector<VoxelFace>& face) {
+    face.push_back({ -1.6f, 10.7f, 0.0f, FACE_SKIN_R, FACE_SKIN_G, FACE_SKIN_B });
+    face.push_back({ -1.6f, 10.9f, 0.0f, FACE_SKIN_R, FACE_SKIN_G, FACE_SKIN_B });
+    face.push_back({ 1.6f, 10.7f, 0.0f, FACE_SKIN_R, FACE_SKIN_G, FACE_SKIN_B });
+    face.push_back({ 1.6f, 10.9f, 0.0f, FACE_SKIN_R, FACE_SKIN_G, FACE_SKIN_B });
 
     for (float y = 11.5f; y <= 12.5f; y += 0.25f) {
         for (float z = -0.5f; z <= 0.2f; z += 0.25f) {
-            face.push_back({ -1.6f, y, z, HAIR_R, HAIR_G, HAIR_B });
+            face.push_back({ -1.6f, y, z, FACE_HAIR_R, FACE_HAIR_G, FACE_HAIR_B });
         }
     }
     for (float y = 11.5f; y <= 12.5f; y += 0.25f) {
         for (float z = -0.5f; z <= 0.2f; z += 0.25f) {
-            face.push_back({ 1.6f, y, z, HAIR_R, HAIR_G, HAIR_B });
+            face.push_back({ 1.6f, y, z, FACE_HAIR_R, FACE_HAIR_G, FACE_HAIR_B });
         }
     }
+}
+
+// ***  1: ī (Scanner Effect) ***
+// һ (-1.3) ɨ (1.3)
+// fmod ѭٶΪ 2.0
+float faceGlintPosition(float time) {
+    return -1.5f + fmod(time * 2.5f, 3.5f);
+}
+
+// ھƬΧڣͻƬҾƬ
+bool faceGlintVisible(float scanPos) {
+    return (scanPos >= -1.3f && scanPos <= -0.2f) || (scanPos >= 0.2f && scanPos <= 1.3f);
+}
+
+// ***  2: ü (Eyebrow Raise) ***
+// ʹ sin ƫ
+// sin(time * 5.0)  -1  1 Ĳ
+// * 0.15f Ʋȣüëɳ
+// abs() ȷüëֻѹ
+float faceBrowOffset(float time) {
+    return std::fabs(sin(time * 4.0f)) * 0.2f;
+}
+
+// ***  3:  (Breathing) ***
+//  Y ᷽΢Сģ
+float breathScaleAt(float time) {
+    return 1.0f + sin(time * 2.0f) * 0.01f;
+}
+
+std::vector<VoxelFace> createFaceDetails(float time) {
+    std::vector<VoxelFace> face;
+
+    addFaceGlasses(face);
+
+    float scanPos = faceGlintPosition(time);
+    if (faceGlintVisible(scanPos)) {
+        face.push_back({ scanPos, GLINT_Y, Z_POP + 0.05f, GLINT_R, GLINT_G, GLINT_B });
+    }
+
+    addFaceNoseAndMouth(face);
+    addFaceBrows(face, faceBrowOffset(time));
+    addFaceEarsAndHair(face);
 
     return face;
 }
 
+FaceParts createFaceParts() {
+    FaceParts parts;
+    addFaceGlasses(parts.rest);
+    addFaceNoseAndMouth(parts.rest);
+    addFaceEarsAndHair(parts.rest);
+    addFaceBrows(parts.brows, 0.0f);
+    parts.glint.push_back({ 0.0f, GLINT_Y, Z_POP + 0.05f, GLINT_R, GLINT_G, GLINT_B });
+    return parts;
+}
+
 
 // [] 򵥵ѩϵͳ
 // ô洢״ֱ̬ùϣʱλ
-void drawSnow(float time) {
-    // رչպȷѩǴ׵ɫ
-    glDisable(GL_LIGHTING);
-    glColor3f(1.0f, 1.0f, 1.0f);
-
-    // õĴС
-    glPointSize(3.0f);
+std::vector<Voxel> createSnowParticles(float time) {
+    std::vector<Voxel> snow;
+    snow.reserve(2000);
 
-    glBegin(GL_POINTS);
     //  2000 Ƭѩ
     for (int i = 0; i < 2000; ++i) {
         //  i 
@@ -530,9 +518,24 @@ void drawSnow(float time) {
         if (y > -5.0f) {
             // 򵥵ҡЧ (Wind)
             float wind = sin(time * 0.5f + y * 0.1f) * 2.0f;
-            glVertex3f(x + wind, y, z);
+            snow.push_back({ x + wind, y, z, 1.0f, 1.0f, 1.0f });
         }
     }
+    return snow;
+}
+
+void drawSnow(float time) {
+    // رչպȷѩǴ׵ɫ
+    glDisable(GL_LIGHTING);
+    glColor3f(1.0f, 1.0f, 1.0f);
+
+    // õĴС
+    glPointSize(3.0f);
+
+    glBegin(GL_POINTS);
+    for (const auto& p : createSnowParticles(time)) {
+        glVertex3f(p.x, p.y, p.z);
+    }
     glEnd();
 
     // ָգӰ
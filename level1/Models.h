@@ -3,33 +3,62 @@
 
 #include <vector>
 #include "Voxel.h"// VoxelVoxelWatchĶ
+#include "SceneFile.h"
 
-// һԻVoxelvector
-std::vector<Voxel> createSelfPortraitModel();
+class JobSystem;
 
-// ֱģͺʵһ£
-std::vector<VoxelWatch> createWatchModel();
+// Իģͣں決ȥز޳ڲأֻΣ
+VoxelSpan<Voxel> bakedSelfPortraitModel();
+
+// ֱģͣͬϣ
+VoxelSpan<VoxelWatch> bakedWatchModel();
 
 // ϸģ
 std::vector<VoxelFace> createFaceDetails(float time);
 
+// ϸڰ𿪣ֹ֡üëƫΪ 0⣨x Ϊ 0 faceGlintPosition ƽƣ
+// Ⱥģʽɫںʱʹ
+struct FaceParts {
+    std::vector<VoxelFace> rest;
+    std::vector<VoxelFace> brows;
+    std::vector<VoxelFace> glint;
+};
+FaceParts createFaceParts();
+
+// createFaceDetailsȺģʽɫͬһ׹ʽ
+float faceGlintPosition(float time);
+bool faceGlintVisible(float scanPos);
+float faceBrowOffset(float time);
+float breathScaleAt(float time);
+
 
 // һVoxelvector
-std::vector<Voxel> createLandscapeModel();
+// ʱвɣ봮ȫͬĬϲԭľ
+std::vector<Voxel> createLandscapeModel(const LandscapeDesc& desc = LandscapeDesc(), JobSystem* jobs = nullptr);
 
 
 
 // ̬ˮ棨ֱӵûָvector
 void drawAnimatedWater(float time);
 
+// ĳһʱ̵ˮ淽飨drawAnimatedWater Ⱦã
+std::vector<Voxel> createWaterModel(float time);
+
+// ֹˮ棨ûвˣGPU ʵʱɫ
+std::vector<Voxel> createWaterSurface();
+
+// ˮ (x, z) ĳһʱ̵Ĳ˸߶
+float waterWaveHeight(float x, float z, float time);
+
 // [] ѩ
 void drawSnow(float time);
 
+// ĳһʱ̿ɼѩλãɫ̶Ϊɫ
+std::vector<Voxel> createSnowParticles(float time);
 
-// ؾϸģ
-std::vector<VoxelName> createDetailedNameModel();
 
-//  time ü⶯
-std::vector<VoxelFace> createFaceDetails(float time);
+// ؾϸģ
+//  VoxelFont Ļ棬ɫλùϣõglyphShadeͬһĸκʱɵĽͬ
+std::vector<VoxelName> createDetailedNameModel(const NameDesc& desc = NameDesc());
 
 #endif // MODELS_H
\ No newline at end of file
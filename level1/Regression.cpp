@@ -0,0 +1,331 @@
+#include "Regression.h"
+#include "Camera.h"
+#include "SceneState.h"
+#include "SoftwareRenderer.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+// عԵĻСͼС¼
+static const int REGRESSION_WIDTH = 320;
+static const int REGRESSION_HEIGHT = 180;
+
+static double nowMs() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+ImageDiff compareImages(const unsigned char* a, const unsigned char* b, int width, int height, int tolerance) {
+    ImageDiff diff = { 0.0, 0, 0.0 };
+    long long pixels = (long long)width * height;
+    if (pixels <= 0) return diff;
+
+    long long total = 0, over = 0;
+    for (long long i = 0; i < pixels; ++i) {
+        bool exceeds = false;
+        for (int c = 0; c < 3; ++c) {
+            int d = abs((int)a[i * 3 + c] - (int)b[i * 3 + c]);
+            total += d;
+            if (d > diff.maxDiff) diff.maxDiff = d;
+            if (d > tolerance) exceeds = true;
+        }
+        over += exceeds;
+    }
+    diff.meanDiff = (double)total / (pixels * 3);
+    diff.overFraction = (double)over / pixels;
+    return diff;
+}
+
+bool loadTimingBaseline(const char* path, TimingBaseline& out) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+
+    out = TimingBaseline();
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\r\n")] = 0;
+        if (strncmp(line, "renderer ", 9) == 0) {
+            out.renderer = line + 9;
+            continue;
+        }
+        char name[256];
+        double ms;
+        if (sscanf(line, "%255s %lf", name, &ms) == 2) out.frameMs[name] = ms;
+    }
+    fclose(f);
+    return true;
+}
+
+bool saveTimingBaseline(const char* path, const TimingBaseline& baseline) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+
+    fprintf(f, "renderer %s\n", baseline.renderer.c_str());
+    for (const auto& entry : baseline.frameMs) fprintf(f, "%s %.3f\n", entry.first.c_str(), entry.second);
+    return fclose(f) == 0;
+}
+
+bool makeDirectory(const char* path) {
+    struct stat st;
+    if (stat(path, &st) == 0) return (st.st_mode & S_IFDIR) != 0;
+#ifdef _WIN32
+    return _mkdir(path) == 0;
+#else
+    return mkdir(path, 0755) == 0;
+#endif
+}
+
+// ظջһ֡GL ĵһ棬PPM 棩
+static void readFrame(int width, int height, std::vector<unsigned char>& image) {
+    std::vector<unsigned char> pixels((size_t)width * height * 3);
+    glReadBuffer(GL_BACK);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+    image.resize(pixels.size());
+    for (int y = 0; y < height; ++y) {
+        memcpy(&image[(size_t)y * width * 3], &pixels[(size_t)(height - 1 - y) * width * 3], (size_t)width * 3);
+    }
+}
+
+// عԵһ· GL ·Լ CPU ߲Ⱦ
+struct SuitePath {
+    const char* name;       // ͼ֡ʱļǰ׺
+    bool cpu;
+    RenderPath path;        // GL ·cpu Ϊ true ʱã
+};
+
+// Զ˾ÿһĻÿ·һ֡ dir ĽͼȽϣ· CPU ·ͬһĻ drawCube Ƚ
+// update Ϊ true ʱ¼¼ͼ֡ʱ䣻쳬ݲ֡ʱȻֵʱ 1
+static int runRegressionSuite(const char* dir, bool update, JobSystem* jobs) {
+    const int FRAMES = 5;                   // ÿĻʱ֡ȡóɼ׼ͬ
+    const int PIXEL_TOLERANCE = 16;         // ֵͨͬ
+    const double MAX_OVER_FRACTION = 0.001; // ͬ 0.1%
+    const double MAX_MEAN_DIFF = 0.5;
+    //  drawCube ĽȽϣ·ĹԴ̶ʣµĲ
+    // - ·̬ģͺ決 AOవ 50%հǰֵûи߹
+    //   Ļʵƽ 1.5 - 2.4ͨ 64 ز 0.02%Դʱƽ 30 
+    // - CPU ·չʽֻͬϸصĸǲͬʵⳬ 16 ز 0.1%
+    const int PACKED_CROSS_TOLERANCE = 64;
+    const double PACKED_CROSS_OVER_FRACTION = 0.005;
+    const double PACKED_CROSS_MEAN_DIFF = 4.0;
+    const double CPU_CROSS_OVER_FRACTION = 0.005;
+    // ÿ·Ļ֡ʱ֮ͱȻ 30% ܻˣĻʱ䲨ϴֵſ 50%
+    // ֻĳһĻʱҲܷ֡߶ SLACK_MS̵ܶ֡Ϊʱ
+    const double MAX_SLOWDOWN = 1.3;
+    const double MAX_ACT_SLOWDOWN = 1.5;
+    const double SLACK_MS = 2.0;
+    // ɫɫ glyphShade Ĺϣλͬɫʽֻͬ 8 λ 1 
+    // ٸԵϹդǲͬ 0.1%
+    const int GLYPH_TOLERANCE = 1;
+    const double GLYPH_OVER_FRACTION = 0.001;
+    const int width = REGRESSION_WIDTH, height = REGRESSION_HEIGHT;
+
+    std::string timingsPath = std::string(dir) + "/timings.txt";
+    const char* rendererName = (const char*)glGetString(GL_RENDERER);
+    std::string renderer = rendererName ? rendererName : "unknown";
+
+    TimingBaseline baseline, measured;
+    measured.renderer = renderer;
+    bool checkTimes = false;
+    bool recordTimes = update;
+    if (update) {
+        if (!makeDirectory(dir)) {
+            printf("cannot create %s\n", dir);
+            return 1;
+        }
+    } else if (!loadTimingBaseline(timingsPath.c_str(), baseline)) {
+        // ֡ʱͻйأ汾⣺һμʱΪ֮ȽϵĻ
+        printf("no timings in %s, this run becomes the local baseline\n", dir);
+        recordTimes = true;
+    } else if (baseline.renderer != renderer) {
+        printf("timings were recorded on \"%s\", this is \"%s\"; skipping the performance check\n",
+            baseline.renderer.c_str(), renderer.c_str());
+    } else {
+        checkTimes = true;
+    }
+
+    printf("regression %s on %s, %d x %d, best of %d frames\n", update ? "update" : "check", renderer.c_str(),
+        width, height, FRAMES);
+    printf("%-10s %6s %10s %10s %10s %9s %11s  %s\n", "path", "time", "frame(ms)", "baseline", "mean diff", "> tol",
+        "vs drawCube", "result");
+
+    RenderPath savedPath = renderPath();
+    const SuitePath paths[] = {
+        { "immediate", false, RENDER_PATH_IMMEDIATE },
+        { "packed", false, RENDER_PATH_PACKED },
+        { "cpu", true, RENDER_PATH_IMMEDIATE }
+    };
+    SoftwareRenderer cpuRenderer(width, height);
+    std::vector<unsigned char> image, golden;
+    std::vector<std::vector<unsigned char>> reference(CAMERA_ACT_COUNT);     // ÿһĻ drawCube 
+    int failures = 0;
+    for (const SuitePath& path : paths) {
+        if (!path.cpu && !setRenderPath(path.path)) {
+            printf("%-10s skipped (packed vertex path unavailable)\n", path.name);
+            continue;
+        }
+        double pathMs = 0.0, basePathMs = 0.0;
+        bool pathHasBase = checkTimes;
+
+        for (int act = 0; act < CAMERA_ACT_COUNT; ++act) {
+            float time = CAMERA_ACT_TIMES[act];
+            setSceneTime(time);
+
+            // һ֡Ԥȣ֮ÿ֡Ļ涼ͬCPU ·һ֡ռȾ
+            auto renderFrame = [&]() {
+                if (path.cpu) {
+                    buildCpuScene(cpuRenderer, time);
+                    cpuRenderer.render(sceneCamera(), jobs);
+                } else {
+                    renderScene(time);
+                    glFinish();
+                }
+            };
+            renderFrame();
+            std::vector<double> frameMs;
+            for (int f = 0; f < FRAMES; ++f) {
+                double start = nowMs();
+                renderFrame();
+                frameMs.push_back(nowMs() - start);
+            }
+            double ms = *std::min_element(frameMs.begin(), frameMs.end());
+
+            if (path.cpu) image = cpuRenderer.pixels();
+            else readFrame(width, height, image);
+
+            char key[64];
+            snprintf(key, sizeof(key), "%s_%.1f", path.name, time);
+            std::string imagePath = std::string(dir) + "/" + key + ".ppm";
+            measured.frameMs[key] = ms;
+            pathMs += ms;
+
+            const char* result = "ok";
+            ImageDiff diff = { 0.0, 0, 0.0 };
+            double base = checkTimes && baseline.frameMs.count(key) ? baseline.frameMs[key] : -1.0;
+            if (base >= 0.0) basePathMs += base;
+            else pathHasBase = false;
+            int goldenWidth = 0, goldenHeight = 0;
+            bool imageFailed = false;
+            if (update) {
+                if (!writeImagePPM(imagePath.c_str(), width, height, image.data())) result = "cannot write golden";
+                else result = "recorded";
+            } else if (!readImagePPM(imagePath.c_str(), goldenWidth, goldenHeight, golden)) {
+                result = "FAIL: missing golden";
+            } else if (goldenWidth != width || goldenHeight != height) {
+                result = "FAIL: golden size differs";
+            } else {
+                diff = compareImages(image.data(), golden.data(), width, height, PIXEL_TOLERANCE);
+                if (diff.overFraction > MAX_OVER_FRACTION || diff.meanDiff > MAX_MEAN_DIFF) {
+                    result = "FAIL: image";
+                    imageFailed = true;
+                }
+            }
+
+            // ͬһĻ drawCube Ƚϣͼ¼ͼʱҲ飩
+            ImageDiff cross = { 0.0, 0, 0.0 };
+            bool hasCross = !reference[act].empty() && !(path.path == RENDER_PATH_IMMEDIATE && !path.cpu);
+            if (!hasCross) {
+                reference[act] = image;
+            } else {
+                bool crossOk;
+                if (path.cpu) {
+                    cross = compareImages(image.data(), reference[act].data(), width, height, PIXEL_TOLERANCE);
+                    crossOk = cross.overFraction <= CPU_CROSS_OVER_FRACTION && cross.meanDiff <= MAX_MEAN_DIFF;
+                } else {
+                    cross = compareImages(image.data(), reference[act].data(), width, height, PACKED_CROSS_TOLERANCE);
+                    crossOk = cross.overFraction <= PACKED_CROSS_OVER_FRACTION && cross.meanDiff <= PACKED_CROSS_MEAN_DIFF;
+                }
+                if (!crossOk && (strcmp(result, "ok") == 0 || strcmp(result, "recorded") == 0)) {
+                    result = "FAIL: differs from drawCube";
+                    imageFailed = true;
+                }
+            }
+            // һµĻдڽͼԱߣԱ
+            if (imageFailed) {
+                writeImagePPM((std::string(dir) + "/" + key + ".actual.ppm").c_str(), width, height, image.data());
+            }
+
+            if (base >= 0.0 && ms > base * MAX_ACT_SLOWDOWN + SLACK_MS && strcmp(result, "ok") == 0) {
+                result = "FAIL: slower";
+            }
+            if (strcmp(result, "ok") != 0 && strcmp(result, "recorded") != 0) ++failures;
+
+            printf("%-10s %6.1f %10.2f", path.name, time, ms);
+            if (base >= 0.0) printf(" %10.2f", base); else printf(" %10s", "-");
+            printf(" %10.3f %8.3f%%", diff.meanDiff, diff.overFraction * 100.0);
+            if (hasCross) printf(" %11.3f", cross.meanDiff); else printf(" %11s", "-");
+            printf("  %s\n", result);
+        }
+
+        const char* result = "ok";
+        if (pathHasBase && pathMs > basePathMs * MAX_SLOWDOWN + SLACK_MS) {
+            result = "FAIL: slower";
+            ++failures;
+        }
+        printf("%-10s %6s %10.2f", path.name, "total", pathMs);
+        if (pathHasBase) printf(" %10.2f %33s  %s\n", basePathMs, "", result); else printf(" %10s\n", "-");
+    }
+    setRenderPath(savedPath);
+
+    // ֵΣɫɫ CPU  glyphShade ĽdrawCube չ֣Ƚϣӹպ
+    std::vector<unsigned char> cpuColors;
+    if (renderNameOnly(false)) {
+        readFrame(width, height, cpuColors);
+        if (!renderNameOnly(true)) {
+            printf("%-10s skipped (packed vertex path unavailable)\n", "glyphs");
+        } else {
+            readFrame(width, height, image);
+            ImageDiff diff = compareImages(image.data(), cpuColors.data(), width, height, GLYPH_TOLERANCE);
+            const char* result = "ok";
+            if (diff.overFraction > GLYPH_OVER_FRACTION) {
+                result = "FAIL: glyph colors differ from glyphShade";
+                ++failures;
+                writeImagePPM((std::string(dir) + "/glyphs.actual.ppm").c_str(), width, height, image.data());
+                writeImagePPM((std::string(dir) + "/glyphs.expected.ppm").c_str(), width, height, cpuColors.data());
+            }
+            printf("%-10s %6s %10s %10s %10.3f %8.3f%% %11s  %s  (max diff %d)\n", "glyphs", "-", "-", "-",
+                diff.meanDiff, diff.overFraction * 100.0, "-", result, diff.maxDiff);
+        }
+    }
+
+    if (failures > 0) {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    if (recordTimes) {
+        if (!saveTimingBaseline(timingsPath.c_str(), measured)) {
+            printf("cannot write %s\n", timingsPath.c_str());
+            return 1;
+        }
+        printf("timings recorded in %s\n", timingsPath.c_str());
+    }
+    printf("%s\n", update ? "golden images recorded" : "all checks passed");
+    return 0;
+}
+
+// ÷--bench regression [goldenDir] [update]
+// դ GL Ⱦ֡ʱйأԿ޹
+int runRegressionBenchmark(int argc, char** argv) {
+    const char* dir = argc > 0 ? argv[0] : "golden";
+    bool update = argc > 1 && strcmp(argv[1], "update") == 0;
+
+#ifndef _WIN32
+    // Mesa դѾùʱԭֵ
+    setenv("LIBGL_ALWAYS_SOFTWARE", "1", 0);
+#endif
+    JobSystem* jobs = createJobSystem();
+    openSceneWindow("regression", REGRESSION_WIDTH, REGRESSION_HEIGHT);
+    return runRegressionSuite(dir, update, jobs);
+}
\ No newline at end of file
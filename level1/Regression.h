@@ -0,0 +1,34 @@
+#ifndef REGRESSION_H
+#define REGRESSION_H
+
+#include <map>
+#include <string>
+
+// عԣԶ˾ÿһĻÿ·ϸһ֡ͽͼݲȽϣ֡ʱͼ¼Ļ߱Ƚ
+// ÷main --bench regression [goldenDir] [update]
+int runRegressionBenchmark(int argc, char** argv);
+
+// ǱȽϲ֣漰 GL
+
+struct ImageDiff {
+    double meanDiff;        // ֵͨƽ0 - 255
+    int maxDiff;            // ֵͨ
+    double overFraction;    // ֵͨݲر
+};
+
+ImageDiff compareImages(const unsigned char* a, const unsigned char* b, int width, int height, int tolerance);
+
+// ֡ʱļһ "renderer <GL_RENDERER>"֮ÿ "<> <>"
+// ֻͬһȾϼ¼ʱпɱԣļֻڱ汾
+struct TimingBaseline {
+    std::string renderer;
+    std::map<std::string, double> frameMs;
+};
+
+bool loadTimingBaseline(const char* path, TimingBaseline& out);
+bool saveTimingBaseline(const char* path, const TimingBaseline& baseline);
+
+// Ŀ¼ʱֻһ
+bool makeDirectory(const char* path);
+
+#endif // REGRESSION_H
\ No newline at end of file
@@ -0,0 +1,288 @@
+#include "SceneFile.h"
+#include "VoxelFont.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+bool operator==(const NameDesc& a, const NameDesc& b) {
+    if (a.z != b.z || a.letters.size() != b.letters.size()) return false;
+    for (size_t i = 0; i < a.letters.size(); ++i) {
+        const NameLetter& p = a.letters[i];
+        const NameLetter& q = b.letters[i];
+        if (p.ch != q.ch || p.x != q.x || p.r != q.r || p.g != q.g || p.b != q.b) return false;
+    }
+    return true;
+}
+
+bool operator==(const LandscapeDesc& a, const LandscapeDesc& b) {
+    return a.walkX0 == b.walkX0 && a.walkX1 == b.walkX1 && a.walkZ0 == b.walkZ0 && a.walkZ1 == b.walkZ1 &&
+        a.walkY == b.walkY && a.railY == b.railY && a.railZ == b.railZ && a.postSpacing == b.postSpacing &&
+        a.mountainZ0 == b.mountainZ0 && a.mountainZ1 == b.mountainZ1 &&
+        a.mountainBase == b.mountainBase && a.mountainSlope == b.mountainSlope &&
+        a.mountainSin == b.mountainSin && a.mountainCos == b.mountainCos &&
+        a.rockLine == b.rockLine && a.snowLine == b.snowLine;
+}
+
+static std::string trim(const std::string& s) {
+    size_t begin = 0, end = s.size();
+    while (begin < end && isspace((unsigned char)s[begin])) ++begin;
+    while (end > begin && isspace((unsigned char)s[end - 1])) --end;
+    return s.substr(begin, end - begin);
+}
+
+//  values  count ԡзֻ inf / nan ʱ false
+static bool parseFloats(const std::string& values, float* out, int count) {
+    std::istringstream in(values);
+    for (int i = 0; i < count; ++i) {
+        std::string token;
+        if (!(in >> token)) return false;
+        char* end = nullptr;
+        out[i] = strtof(token.c_str(), &end);
+        if (end == token.c_str() || *end != '\0' || !std::isfinite(out[i])) return false;
+    }
+    std::string extra;
+    return !(in >> extra);
+}
+
+//  float ϼ鷶ΧС֣ int  float תδΪ
+static bool parseInts(const std::string& values, int* out, int count) {
+    float f[8];
+    if (count > 8 || !parseFloats(values, f, count)) return false;
+    for (int i = 0; i < count; ++i) {
+        if (std::fabs(f[i]) > SCENE_MAX_EXTENT || f[i] != std::floor(f[i])) return false;
+        out[i] = (int)f[i];
+    }
+    return true;
+}
+
+static bool withinExtent(const float* v, int count) {
+    for (int i = 0; i < count; ++i) {
+        if (std::fabs(v[i]) > SCENE_MAX_EXTENT) return false;
+    }
+    return true;
+}
+
+// ɽ߸߶ȣ createLandscapeModel ĸ߶ȹʽһ£ / ȡȣ
+static float maxMountainHeight(const LandscapeDesc& l) {
+    float highest = -SCENE_MAX_EXTENT;
+    for (int z = l.mountainZ0; z <= l.mountainZ1; ++z) {
+        float distanceFactor = (float)(abs(z) - abs(l.mountainZ1)) * l.mountainSlope;
+        highest = std::max(highest, l.mountainBase + distanceFactor);
+    }
+    return highest + std::fabs(l.mountainSin) + std::fabs(l.mountainCos);
+}
+
+// createLandscapeModel ɵϽ磺ջ +  +  + ÿɽ (߶ + 10) 
+static long long landscapeVoxelBound(const LandscapeDesc& l) {
+    long long width = (long long)l.walkX1 - l.walkX0 + 1;
+    long long depth = (long long)l.walkZ1 - l.walkZ0 + 1;
+    long long posts = (width + l.postSpacing - 1) / l.postSpacing;
+    long long postHeight = (long long)std::max(0.0f, std::ceil(l.railY));
+    long long mountainDepth = (long long)l.mountainZ1 - l.mountainZ0 + 1;
+    long long column = (long long)std::max(0.0f, std::ceil(maxMountainHeight(l)) + 10.0f);
+    return width * depth + width + posts * postHeight + width * mountainDepth * column;
+}
+
+bool loadSceneFile(const char* path, SceneDesc& out, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = std::string(path) + ": cannot open";
+        return false;
+    }
+
+    SceneDesc scene;
+    bool lettersCleared = false;    // ļһγ letter ʱĬϵ L / Y / T
+    int letterLine = 0;             // letter / text / color ֵУļּ鱨
+    int textLine = 0;
+    int colorLine = 0;
+    std::string text;               // text У֡һַĺ־
+    float textOrigin = 0.0f, textAdvance = 0.0f;
+    std::vector<NameLetter> textColors;     // color У˳ѭĸɫֻ r / g / b
+    std::string section;
+    std::string line;
+    int lineNumber = 0;
+    int landscapeLine = 0;          // һ޸ [landscape] У޼鱨һ
+
+    auto fail = [&](const std::string& reason) {
+        error = std::string(path) + ":" + std::to_string(lineNumber) + ": " + reason;
+        return false;
+    };
+
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        if (line.front() == '[') {
+            if (line.back() != ']') return fail("unterminated section header");
+            section = trim(line.substr(1, line.size() - 2));
+            if (section != "figure" && section != "name" && section != "landscape") {
+                return fail("unknown section [" + section + "]");
+            }
+            continue;
+        }
+
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) return fail("expected key = value");
+        std::string key = trim(line.substr(0, eq));
+        std::string value = trim(line.substr(eq + 1));
+        bool ok = true;
+
+        if (section == "figure") {
+            if (key == "position") ok = parseFloats(value, scene.figurePosition, 3) && withinExtent(scene.figurePosition, 3);
+            else return fail("unknown key '" + key + "' in [figure]");
+        }
+        else if (section == "name") {
+            if (key == "z") {
+                ok = parseFloats(value, &scene.name.z, 1) && withinExtent(&scene.name.z, 1);
+            }
+            else if (key == "letter") {
+                // letter = <ַ> <x> <r> <g> <b>
+                std::string rest = value;
+                if (rest.empty() || isspace((unsigned char)rest[0])) return fail("letter needs a character");
+                NameLetter letter;
+                letter.ch = (char)toupper((unsigned char)rest[0]);
+                if (!isalnum((unsigned char)letter.ch)) return fail("letters must be A-Z or 0-9");
+                float v[4];
+                ok = parseFloats(rest.substr(1), v, 4) && withinExtent(v, 1);
+                letter.x = v[0]; letter.r = v[1]; letter.g = v[2]; letter.b = v[3];
+                if (ok) {
+                    if (!lettersCleared) scene.name.letters.clear();
+                    if (scene.name.letters.size() >= SCENE_MAX_LETTERS) {
+                        return fail("too many letters (limit " + std::to_string(SCENE_MAX_LETTERS) + ")");
+                    }
+                    lettersCleared = true;
+                    scene.name.letters.push_back(letter);
+                    letterLine = lineNumber;
+                }
+            }
+            else if (key == "text") {
+                // text = <һַx> <־> <>пո
+                std::istringstream in(value);
+                std::string origin, advance;
+                in >> origin >> advance;
+                std::string rest;
+                std::getline(in, rest);
+                float v[2];
+                ok = parseFloats(origin + " " + advance, v, 2) && withinExtent(v, 2);
+                text = trim(rest);
+                if (ok && text.empty()) return fail("text needs at least one character");
+                if (ok) {
+                    textOrigin = v[0];
+                    textAdvance = v[1];
+                    textLine = lineNumber;
+                }
+            }
+            else if (key == "color") {
+                NameLetter color = {};
+                float v[3];
+                ok = parseFloats(value, v, 3);
+                if (ok) {
+                    color.r = v[0]; color.g = v[1]; color.b = v[2];
+                    textColors.push_back(color);
+                    colorLine = lineNumber;
+                }
+            }
+            else {
+                return fail("unknown key '" + key + "' in [name]");
+            }
+        }
+        else if (section == "landscape") {
+            LandscapeDesc& l = scene.landscape;
+            if (key == "walk") {
+                int v[4];
+                ok = parseInts(value, v, 4);
+                if (ok) { l.walkX0 = v[0]; l.walkX1 = v[1]; l.walkZ0 = v[2]; l.walkZ1 = v[3]; }
+            }
+            else if (key == "walk_y") {
+                ok = parseFloats(value, &l.walkY, 1) && withinExtent(&l.walkY, 1);
+            }
+            else if (key == "rail") {
+                float v[2];
+                ok = parseFloats(value, v, 2) && withinExtent(v, 2);
+                if (ok) { l.railY = v[0]; l.railZ = v[1]; }
+            }
+            else if (key == "post_spacing") {
+                ok = parseInts(value, &l.postSpacing, 1) && l.postSpacing > 0;
+            }
+            else if (key == "mountain_z") {
+                int v[2];
+                ok = parseInts(value, v, 2);
+                if (ok) { l.mountainZ0 = v[0]; l.mountainZ1 = v[1]; }
+            }
+            else if (key == "mountain_height") {
+                float v[4];
+                ok = parseFloats(value, v, 4);
+                if (ok) { l.mountainBase = v[0]; l.mountainSlope = v[1]; l.mountainSin = v[2]; l.mountainCos = v[3]; }
+            }
+            else if (key == "rock_line") {
+                ok = parseInts(value, &l.rockLine, 1);
+            }
+            else if (key == "snow_line") {
+                ok = parseInts(value, &l.snowLine, 1);
+            }
+            else {
+                return fail("unknown key '" + key + "' in [landscape]");
+            }
+            if (ok && (l.walkX0 > l.walkX1 || l.walkZ0 > l.walkZ1 || l.mountainZ0 > l.mountainZ1)) {
+                return fail("range start must not be greater than its end");
+            }
+            if (ok) landscapeLine = lineNumber;
+        }
+        else {
+            return fail("key outside of a section");
+        }
+
+        if (!ok) return fail("bad value for '" + key + "': " + value);
+    }
+
+    // ŰҪ text  color ж
+    if (textLine > 0) {
+        lineNumber = textLine;
+        if (letterLine > 0) return fail("use either letter or text lines in [name], not both");
+        std::vector<GlyphPlacement> placed;
+        char bad = 0;
+        if (!layoutText(text, textOrigin, textAdvance, placed, &bad)) {
+            return fail(std::string("no glyph for '") + bad + "' (text must be A-Z, 0-9 or spaces)");
+        }
+        if (placed.size() > SCENE_MAX_LETTERS) {
+            return fail("too many letters (limit " + std::to_string(SCENE_MAX_LETTERS) + ")");
+        }
+        float lastX = textOrigin + textAdvance * (float)(text.size() - 1);
+        if (!withinExtent(&lastX, 1)) return fail("text runs past +/-" + std::to_string((int)SCENE_MAX_EXTENT));
+        // û color ʱĬֵɫ
+        if (textColors.empty()) textColors = NameDesc().letters;
+        scene.name.letters.clear();
+        for (size_t i = 0; i < placed.size(); ++i) {
+            NameLetter letter = textColors[i % textColors.size()];
+            letter.ch = placed[i].ch;
+            letter.x = placed[i].x;
+            scene.name.letters.push_back(letter);
+        }
+    }
+    else if (colorLine > 0) {
+        lineNumber = colorLine;
+        return fail("color lines need a text line");
+    }
+
+    // ɽĸ߶Ⱥȡڶļټ
+    lineNumber = landscapeLine;
+    if (maxMountainHeight(scene.landscape) > SCENE_MAX_EXTENT) {
+        return fail("mountains higher than " + std::to_string((int)SCENE_MAX_EXTENT));
+    }
+    long long voxels = landscapeVoxelBound(scene.landscape);
+    if (voxels > SCENE_MAX_LANDSCAPE_VOXELS) {
+        return fail("landscape needs up to " + std::to_string(voxels) + " voxels (limit " +
+            std::to_string(SCENE_MAX_LANDSCAPE_VOXELS) + ")");
+    }
+
+    out = scene;
+    return true;
+}
\ No newline at end of file
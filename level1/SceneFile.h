@@ -0,0 +1,67 @@
+#ifndef SCENE_FILE_H
+#define SCENE_FILE_H
+
+#include <string>
+#include <vector>
+#include "SceneParams.h"
+
+// ļ (scene.txt)ڳʱ޸ģԶӰģ
+// ʽ
+//   # ע
+//   [section]
+//   key = value value ...
+// Ĭֵԭд Models.cpp ĲͬļȱʧʱĬϳ
+
+// һĸ[name] д letter УҲдһ text  color 
+// text  layoutText Ű棬ɫ˳ѭʹã
+struct NameLetter {
+    char ch;                // A-Z  0-9μ VoxelFont
+    float x;                // ĸ
+    float r, g, b;          // ɫٵӸ߶ / Ƚ㣩
+};
+
+struct NameDesc {
+    float z = 8.0f;         // ĸڵ z
+    std::vector<NameLetter> letters = {
+        { 'L', -17.0f, 0.0f, 0.6f, 1.0f },
+        { 'Y', -12.0f, 0.8f, 0.0f, 1.0f },
+        { 'T', -7.0f, 1.0f, 0.5f, 0.0f }
+    };
+};
+
+struct LandscapeDesc {
+    int walkX0 = -50, walkX1 = 50;      // ջɽҲͬ x Χ
+    int walkZ0 = -5, walkZ1 = 15;
+    float walkY = -1.0f;
+    float railY = 5.0f;                 // ָ߶
+    float railZ = -4.0f;
+    int postSpacing = 10;               // 
+    int mountainZ0 = -60, mountainZ1 = -25;
+    float mountainBase = 2.0f;          // ߶ = base + (|z| - |z1|) * slope + sinAmp * sin(0.1x) + cosAmp * cos(0.15z)
+    float mountainSlope = 0.4f;
+    float mountainSin = 6.0f;
+    float mountainCos = 3.0f;
+    int rockLine = 5;                   // ߶ɭ
+    int snowLine = 12;                  // ߶ѩ
+};
+
+struct SceneDesc {
+    float figurePosition[3] = { FIGURE_POSITION[0], FIGURE_POSITION[1], FIGURE_POSITION[2] };
+    NameDesc name;
+    LandscapeDesc landscape;
+};
+
+// ޣʱ loadSceneFile ɾ޴Ļģ
+const float SCENE_MAX_EXTENT = 1000.0f;                 // ꣨λáΧɽĸ߶ȣľֵ
+const long long SCENE_MAX_LANDSCAPE_VOXELS = 2000000;   // ޣĬϳԼ 5 
+const size_t SCENE_MAX_LETTERS = 64;
+
+bool operator==(const NameDesc& a, const NameDesc& b);
+bool operator==(const LandscapeDesc& a, const LandscapeDesc& b);
+inline bool operator!=(const NameDesc& a, const NameDesc& b) { return !(a == b); }
+inline bool operator!=(const LandscapeDesc& a, const LandscapeDesc& b) { return !(a == b); }
+
+// ļʧʱ falseerror  "ļ:к: ԭ"out ֲ
+bool loadSceneFile(const char* path, SceneDesc& out, std::string& error);
+
+#endif // SCENE_FILE_H
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "SceneGraph.h"
+
+#include <cmath>
+#include <cstring>
+
+static const float IDENTITY[16] = {
+    1.0f, 0.0f, 0.0f, 0.0f,
+    0.0f, 1.0f, 0.0f, 0.0f,
+    0.0f, 0.0f, 1.0f, 0.0f,
+    0.0f, 0.0f, 0.0f, 1.0f
+};
+
+int SceneGraph::addNode(const char* name, int parent) {
+    Node node;
+    node.name = name;
+    node.parent = parent;
+    node.translation[0] = node.translation[1] = node.translation[2] = 0.0f;
+    node.yaw = 0.0f;
+    node.scale[0] = node.scale[1] = node.scale[2] = 1.0f;
+    memcpy(node.local, IDENTITY, sizeof(IDENTITY));
+    memcpy(node.world, IDENTITY, sizeof(IDENTITY));
+    node.localDirty = true;
+    node.worldChanged = false;
+    nodes.push_back(node);
+    return (int)nodes.size() - 1;
+}
+
+void SceneGraph::setTranslation(int node, float x, float y, float z) {
+    float* t = nodes[node].translation;
+    if (t[0] == x && t[1] == y && t[2] == z) return;
+    t[0] = x; t[1] = y; t[2] = z;
+    markDirty(node);
+}
+
+void SceneGraph::setYaw(int node, float radians) {
+    if (nodes[node].yaw == radians) return;
+    nodes[node].yaw = radians;
+    markDirty(node);
+}
+
+void SceneGraph::setScale(int node, float x, float y, float z) {
+    float* s = nodes[node].scale;
+    if (s[0] == x && s[1] == y && s[2] == z) return;
+    s[0] = x; s[1] = y; s[2] = z;
+    markDirty(node);
+}
+
+int SceneGraph::update() {
+    int recomputed = 0;
+    for (auto& node : nodes) {
+        bool parentChanged = node.parent >= 0 && nodes[node.parent].worldChanged;
+        node.worldChanged = node.localDirty || parentChanged;
+        if (!node.worldChanged) continue;
+
+        if (node.localDirty) {
+            composeTRS(node.translation, node.yaw, node.scale, node.local);
+            node.localDirty = false;
+        }
+        if (node.parent >= 0) multiply(nodes[node.parent].world, node.local, node.world);
+        else memcpy(node.world, node.local, sizeof(node.local));
+        ++recomputed;
+    }
+    return recomputed;
+}
+
+const float* SceneGraph::identity() {
+    return IDENTITY;
+}
+
+void SceneGraph::composeTRS(const float translation[3], float yaw, const float scale[3], float out[16]) {
+    // glRotatef(yaw, 0, 1, 0) ľ
+    float c = std::cos(yaw), s = std::sin(yaw);
+    out[0] = c * scale[0];  out[1] = 0.0f;             out[2] = -s * scale[0]; out[3] = 0.0f;
+    out[4] = 0.0f;          out[5] = scale[1];         out[6] = 0.0f;          out[7] = 0.0f;
+    out[8] = s * scale[2];  out[9] = 0.0f;             out[10] = c * scale[2]; out[11] = 0.0f;
+    out[12] = translation[0]; out[13] = translation[1]; out[14] = translation[2]; out[15] = 1.0f;
+}
+
+void SceneGraph::multiply(const float a[16], const float b[16], float out[16]) {
+    float m[16];
+    for (int c = 0; c < 4; ++c) {
+        for (int r = 0; r < 4; ++r) {
+            m[c * 4 + r] = a[r] * b[c * 4] + a[4 + r] * b[c * 4 + 1] +
+                a[8 + r] * b[c * 4 + 2] + a[12 + r] * b[c * 4 + 3];
+        }
+    }
+    memcpy(out, m, sizeof(m));
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef SCENE_GRAPH_H
+#define SCENE_GRAPH_H
+
+#include <vector>
+
+// ͼÿڵһֲ任 = ڵ * ֲ
+// - ֲ任 = ƽ *  Y ת * ţ glTranslatef + glRotatef + glScalef ˳ͬ
+// - ţֱӽ glLoadMatrixf
+// - ޸ı任ֻǣupdate() ʱ㣻ֵû set òŪڵ
+// - ڵӽڵӣupdate() ˳ɨһ鼴ɴ
+class SceneGraph {
+public:
+    // ؽڵţparent = -1 ʾڸ
+    int addNode(const char* name, int parent = -1);
+
+    void setTranslation(int node, float x, float y, float z);
+    void setYaw(int node, float radians);
+    void setScale(int node, float x, float y, float z);
+
+    // ڵľֲ󣬷ر
+    int update();
+
+    const float* local(int node) const { return nodes[node].local; }
+    const float* world(int node) const { return nodes[node].world; }
+    const char* name(int node) const { return nodes[node].name; }
+    int parent(int node) const { return nodes[node].parent; }
+    int nodeCount() const { return (int)nodes.size(); }
+
+    static const float* identity();
+
+    // ƽ *  Y ת * 
+    static void composeTRS(const float translation[3], float yaw, const float scale[3], float out[16]);
+
+    // out = a * bout Ժ ab ͬһ飩
+    static void multiply(const float a[16], const float b[16], float out[16]);
+
+private:
+    struct Node {
+        const char* name;
+        int parent;
+        float translation[3];
+        float yaw;
+        float scale[3];
+        float local[16];
+        float world[16];
+        bool localDirty;
+        bool worldChanged;      //  update() ӽڵҪ
+    };
+
+    void markDirty(int node) { nodes[node].localDirty = true; }
+
+    std::vector<Node> nodes;
+};
+
+#endif // SCENE_GRAPH_H
\ No newline at end of file
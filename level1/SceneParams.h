@@ -0,0 +1,34 @@
+#ifndef SCENE_PARAMS_H
+#define SCENE_PARAMS_H
+
+// init()/reshape()  GL ״̬
+// ȾͬĲ㣬֤Ⱦ·Ļһ
+
+// ɫ = ɫɫ
+const float SKY_COLOR[4] = { 0.5f, 0.7f, 1.0f, 1.0f };
+
+// EXP2 ģʽܶ
+const float FOG_DENSITY = 0.015f;
+
+// Դ
+const float LIGHT_AMBIENT[4] = { 0.3f, 0.3f, 0.3f, 1.0f };      // ⣬ðȫ
+const float LIGHT_DIFFUSE[4] = { 1.0f, 1.0f, 1.0f, 1.0f };      // ⣬Դ
+const float LIGHT_SPECULAR[4] = { 1.0f, 1.0f, 1.0f, 1.0f };     // 淴⣬߹
+const float LIGHT_POSITION[4] = { 10.0f, 10.0f, 10.0f, 0.0f };  // Դλã⣩
+
+// GL Ĭϵȫֻ
+const float GLOBAL_AMBIENT = 0.2f;
+
+// ʵľ淴
+const float MAT_SPECULAR[4] = { 0.5f, 0.5f, 0.5f, 1.0f };
+const float MAT_SHININESS = 50.0f;
+
+// Ի + ֱ + ڳеĬλãscene.txt  [figure] position Ը
+const float FIGURE_POSITION[3] = { -1.5f, 0.0f, -2.0f };
+
+// ͸ͶӰ
+const float FIELD_OF_VIEW = 45.0f;
+const float NEAR_PLANE = 1.0f;
+const float FAR_PLANE = 200.0f;
+
+#endif // SCENE_PARAMS_H
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef SCENE_STATE_H
+#define SCENE_STATE_H
+
+#include "VoxelRenderer.h"
+
+class Camera;
+class Crowd;
+class JobSystem;
+class SoftwareRenderer;
+class VoxelQuery;
+
+// ״̬խӿڣģ͡Ⱦȫ״̬ main.cpp 
+// ߵCPU Ⱦ׼ԡعԣֻͨĺʣֱȫֱ
+
+// ȫ滻еģthreads Ϊ 0 ʱӲ߳
+JobSystem* createJobSystem(int threads = 0);
+
+// ڵǰ߳ͬģͣҪ GL
+void loadModels();
+
+// ֵĸƵ time ʱ̣ģʽ tick() ÿ֡ƽ
+void setSceneTime(float time);
+const Camera& sceneCamera();
+
+//  width x height  GLUT ڣʼ GL ״̬ͬģͣҪ GL Ĳã
+void openSceneWindow(const char* title, int width, int height);
+
+// һ֡壩
+void renderScene(float time);
+RenderPath renderPath();
+// ·ʱ falseԭ·
+bool setRenderPath(RenderPath path);
+
+// ֻ֣ǰӹպglyphs Ϊ true ʱ·ʵΣɫɫ㣩
+// ģ drawCubeɫ CPU  glyphShade Ľ·ʱ false
+bool renderNameOnly(bool glyphs);
+
+// ȺĬ 1 ˣ
+Crowd& sceneCrowd();
+
+// ǰģ½̬ײݲأʱãʱѾһΣ
+const VoxelQuery& buildSceneCollision();
+
+//  time ʱ̵Ⱦ display() һһӦ
+void buildCpuScene(SoftwareRenderer& renderer, float time);
+
+#endif // SCENE_STATE_H
\ No newline at end of file
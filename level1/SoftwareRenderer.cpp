@@ -0,0 +1,397 @@
+#include "SoftwareRenderer.h"
+#include "Camera.h"
+#include "JobSystem.h"
+#include "SceneParams.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VOXEL_USE_SSE 1
+#endif
+
+static const int TILE_SIZE = 32;
+
+static void normalize3(float v[3]) {
+    float len = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if (len > 0.0f) {
+        v[0] /= len; v[1] /= len; v[2] /= len;
+    }
+}
+
+static float dot3(const float a[3], const float b[3]) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+static void cross3(const float a[3], const float b[3], float out[3]) {
+    out[0] = a[1] * b[2] - a[2] * b[1];
+    out[1] = a[2] * b[0] - a[0] * b[2];
+    out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static unsigned char toByte(float v) {
+    if (v < 0.0f) v = 0.0f;
+    if (v > 1.0f) v = 1.0f;
+    return (unsigned char)(v * 255.0f + 0.5f);
+}
+
+// EXP2  glFogi(GL_FOG_MODE, GL_EXP2) ͬdepth Ϊ۾ռ
+static float fogFactor(float depth) {
+    float d = FOG_DENSITY * depth;
+    float f = std::exp(-d * d);
+    return f < 0.0f ? 0.0f : (f > 1.0f ? 1.0f : f);
+}
+
+SoftwareRenderer::SoftwareRenderer(int width, int height)
+    : imageWidth(width), imageHeight(height) {
+    color.resize((size_t)width * height * 3);
+    depth.resize((size_t)width * height);
+    transform[0] = transform[1] = transform[2] = 0.0f;
+    transform[3] = 1.0f;
+}
+
+void SoftwareRenderer::beginScene() {
+    sceneBoxes.clear();
+    points.clear();
+    setTransform(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+void SoftwareRenderer::setTransform(float tx, float ty, float tz, float scaleY) {
+    transform[0] = tx;
+    transform[1] = ty;
+    transform[2] = tz;
+    transform[3] = scaleY;
+}
+
+void SoftwareRenderer::addVoxel(float x, float y, float z, float size, float r, float g, float b) {
+    float half = size * 0.5f;
+    float halfY = half * transform[3];
+    float cx = transform[0] + x;
+    float cy = transform[1] + y * transform[3];
+    float cz = transform[2] + z;
+
+    VoxelBox box = {
+        { cx - half, cy - halfY, cz - half },
+        { cx + half, cy + halfY, cz + half },
+        r, g, b
+    };
+    sceneBoxes.push_back(box);
+}
+
+void SoftwareRenderer::addPoint(float x, float y, float z, float r, float g, float b) {
+    Point p = { transform[0] + x, transform[1] + y * transform[3], transform[2] + z, r, g, b };
+    points.push_back(p);
+}
+
+void SoftwareRenderer::endScene() {
+    sceneGrid.build(sceneBoxes, 1.0f);
+}
+
+// һͬʱ 4 󽻣ÿߵ
+// ߰㶼۾λãֻзͬ
+static void intersectPacket(const VoxelBox& b, int boxIndex, const float eye[3],
+    const float invX[4], const float invY[4], const float invZ[4], int laneMask,
+    float best[4], int bestBox[4]) {
+#ifdef VOXEL_USE_SSE
+    __m128 nearV = _mm_set1_ps(NEAR_PLANE);
+    __m128 ix = _mm_loadu_ps(invX), iy = _mm_loadu_ps(invY), iz = _mm_loadu_ps(invZ);
+
+    __m128 t1 = _mm_mul_ps(_mm_set1_ps(b.min[0] - eye[0]), ix);
+    __m128 t2 = _mm_mul_ps(_mm_set1_ps(b.max[0] - eye[0]), ix);
+    __m128 tn = _mm_min_ps(t1, t2), tf = _mm_max_ps(t1, t2);
+
+    t1 = _mm_mul_ps(_mm_set1_ps(b.min[1] - eye[1]), iy);
+    t2 = _mm_mul_ps(_mm_set1_ps(b.max[1] - eye[1]), iy);
+    tn = _mm_max_ps(tn, _mm_min_ps(t1, t2));
+    tf = _mm_min_ps(tf, _mm_max_ps(t1, t2));
+
+    t1 = _mm_mul_ps(_mm_set1_ps(b.min[2] - eye[2]), iz);
+    t2 = _mm_mul_ps(_mm_set1_ps(b.max[2] - eye[2]), iz);
+    tn = _mm_max_ps(tn, _mm_min_ps(t1, t2));
+    tf = _mm_min_ps(tf, _mm_max_ps(t1, t2));
+
+    // ڷڲʱȡ棬 VoxelGrid::intersectBox һ
+    __m128 useNear = _mm_cmpge_ps(tn, nearV);
+    __m128 hitT = _mm_or_ps(_mm_and_ps(useNear, tn), _mm_andnot_ps(useNear, tf));
+
+    __m128 bestV = _mm_loadu_ps(best);
+    __m128 lanes = _mm_castsi128_ps(_mm_set_epi32(
+        (laneMask & 8) ? -1 : 0, (laneMask & 4) ? -1 : 0, (laneMask & 2) ? -1 : 0, (laneMask & 1) ? -1 : 0));
+    __m128 valid = _mm_and_ps(_mm_cmpge_ps(tf, tn), _mm_cmpge_ps(hitT, nearV));
+    valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmplt_ps(hitT, bestV), lanes));
+
+    int hits = _mm_movemask_ps(valid);
+    if (!hits) return;
+
+    _mm_storeu_ps(best, _mm_or_ps(_mm_and_ps(valid, hitT), _mm_andnot_ps(valid, bestV)));
+    for (int l = 0; l < 4; ++l) {
+        if (hits & (1 << l)) bestBox[l] = boxIndex;
+    }
+#else
+    for (int l = 0; l < 4; ++l) {
+        if (!(laneMask & (1 << l))) continue;
+        float inv[3] = { invX[l], invY[l], invZ[l] };
+        float t;
+        if (VoxelGrid::intersectBox(b, eye, inv, NEAR_PLANE, best[l], t) && t < best[l]) {
+            best[l] = t;
+            bestBox[l] = boxIndex;
+        }
+    }
+#endif
+}
+
+void SoftwareRenderer::tracePacket(const View& view, const float dx[4], const float dy[4], const float dz[4],
+    int laneMask, int box[4], float t[4]) const {
+    const VoxelGrid& grid = sceneGrid;
+    const std::vector<VoxelBox>& boxes = grid.boxes();
+    const uint32_t* cellBoxes = grid.cellBoxes();
+
+    float invX[4], invY[4], invZ[4];
+    GridWalker walker[4];
+    int alive = 0;
+
+    for (int l = 0; l < 4; ++l) {
+        box[l] = -1;
+        t[l] = FAR_PLANE;
+
+        float d[3] = { dx[l], dy[l], dz[l] };
+        for (int a = 0; a < 3; ++a) {
+            if (std::fabs(d[a]) < 1e-12f) d[a] = 1e-12f;
+        }
+        invX[l] = 1.0f / d[0];
+        invY[l] = 1.0f / d[1];
+        invZ[l] = 1.0f / d[2];
+
+        if ((laneMask & (1 << l)) && walker[l].begin(grid, view.eye, d, NEAR_PLANE, FAR_PLANE)) {
+            alive |= 1 << l;
+        }
+    }
+
+    while (alive) {
+        // ҵһĹߣǷͬһ
+        int lead = 0;
+        while (!(alive & (1 << lead))) ++lead;
+
+        bool coherent = true;
+        for (int l = lead + 1; l < 4; ++l) {
+            if (!(alive & (1 << l))) continue;
+            if (walker[l].cellX != walker[lead].cellX || walker[l].cellY != walker[lead].cellY ||
+                walker[l].cellZ != walker[lead].cellZ) {
+                coherent = false;
+                break;
+            }
+        }
+
+        uint32_t first, last;
+        if (coherent) {
+            // ߰
+            if (walker[lead].occupied(grid, first, last)) {
+                for (uint32_t i = first; i < last; ++i) {
+                    uint32_t b = cellBoxes[i];
+                    intersectPacket(boxes[b], (int)b, view.eye, invX, invY, invZ, alive, t, box);
+                }
+            }
+        }
+        else {
+            // Ѿɢ
+            for (int l = lead; l < 4; ++l) {
+                if (!(alive & (1 << l)) || !walker[l].occupied(grid, first, last)) continue;
+                float inv[3] = { invX[l], invY[l], invZ[l] };
+                for (uint32_t i = first; i < last; ++i) {
+                    uint32_t b = cellBoxes[i];
+                    float hitT;
+                    if (VoxelGrid::intersectBox(boxes[b], view.eye, inv, NEAR_PLANE, t[l], hitT) && hitT < t[l]) {
+                        t[l] = hitT;
+                        box[l] = (int)b;
+                    }
+                }
+            }
+        }
+
+        // ѾڵǰڵĹ߽ǰһ
+        for (int l = lead; l < 4; ++l) {
+            if (!(alive & (1 << l))) continue;
+            if ((box[l] >= 0 && t[l] <= walker[l].tExit) || !walker[l].next(grid)) {
+                alive &= ~(1 << l);
+            }
+        }
+    }
+}
+
+// ̶ͬĹգȫֻ + Դ +  + ߹⣨GL_COLOR_MATERIAL ׷ٻ䣩
+void SoftwareRenderer::shade(const View& view, int boxIndex, float t, const float dir[3], unsigned char out[3]) const {
+    const VoxelBox& b = sceneGrid.boxes()[boxIndex];
+
+    float p[3] = { view.eye[0] + dir[0] * t, view.eye[1] + dir[1] * t, view.eye[2] + dir[2] * t };
+    float n[3];
+    VoxelGrid::boxNormal(b, p, n);
+
+    // ߱任۾ռ
+    float ne[3] = { dot3(n, view.side), dot3(n, view.up), -dot3(n, view.forward) };
+    float nDotL = dot3(ne, view.light);
+    float diffuse = std::max(nDotL, 0.0f);
+    float spec = 0.0f;
+    if (nDotL > 0.0f) {
+        spec = std::pow(std::max(dot3(ne, view.halfVector), 0.0f), MAT_SHININESS);
+    }
+
+    float base[3] = { b.r, b.g, b.b };
+    float fog = fogFactor(t);
+    for (int c = 0; c < 3; ++c) {
+        float lit = base[c] * (GLOBAL_AMBIENT + LIGHT_AMBIENT[c]) +
+            base[c] * diffuse * LIGHT_DIFFUSE[c] +
+            MAT_SPECULAR[c] * LIGHT_SPECULAR[c] * spec;
+        lit = std::min(1.0f, std::max(0.0f, lit));
+        out[c] = toByte(fog * lit + (1.0f - fog) * SKY_COLOR[c]);
+    }
+}
+
+void SoftwareRenderer::renderTile(const View& view, int x0, int y0, int x1, int y1) {
+    const float sx = 2.0f / imageWidth, sy = 2.0f / imageHeight;
+
+    for (int py = y0; py < y1; py += 2) {
+        for (int px = x0; px < x1; px += 2) {
+            // 2x2 һ߰
+            int lx[4] = { px, px + 1, px, px + 1 };
+            int ly[4] = { py, py, py + 1, py + 1 };
+            int laneMask = 0;
+            for (int l = 0; l < 4; ++l) {
+                if (lx[l] < x1 && ly[l] < y1) laneMask |= 1 << l;
+            }
+
+            float dx[4], dy[4], dz[4];
+#ifdef VOXEL_USE_SSE
+            __m128 nx = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(_mm_set_ps(lx[3] + 0.5f, lx[2] + 0.5f, lx[1] + 0.5f, lx[0] + 0.5f),
+                _mm_set1_ps(sx)), _mm_set1_ps(1.0f)), _mm_set1_ps(view.tanHalfX));
+            __m128 ny = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set_ps(ly[3] + 0.5f, ly[2] + 0.5f, ly[1] + 0.5f, ly[0] + 0.5f),
+                _mm_set1_ps(sy))), _mm_set1_ps(view.tanHalfY));
+            __m128 d[3];
+            for (int a = 0; a < 3; ++a) {
+                d[a] = _mm_add_ps(_mm_set1_ps(view.forward[a]),
+                    _mm_add_ps(_mm_mul_ps(nx, _mm_set1_ps(view.side[a])), _mm_mul_ps(ny, _mm_set1_ps(view.up[a]))));
+            }
+            _mm_storeu_ps(dx, d[0]);
+            _mm_storeu_ps(dy, d[1]);
+            _mm_storeu_ps(dz, d[2]);
+#else
+            for (int l = 0; l < 4; ++l) {
+                float nx = ((lx[l] + 0.5f) * sx - 1.0f) * view.tanHalfX;
+                float ny = (1.0f - (ly[l] + 0.5f) * sy) * view.tanHalfY;
+                dx[l] = view.forward[0] + nx * view.side[0] + ny * view.up[0];
+                dy[l] = view.forward[1] + nx * view.side[1] + ny * view.up[1];
+                dz[l] = view.forward[2] + nx * view.side[2] + ny * view.up[2];
+            }
+#endif
+
+            int box[4];
+            float t[4];
+            tracePacket(view, dx, dy, dz, laneMask, box, t);
+
+            for (int l = 0; l < 4; ++l) {
+                if (!(laneMask & (1 << l))) continue;
+                size_t idx = (size_t)ly[l] * imageWidth + lx[l];
+                unsigned char* out = &color[idx * 3];
+                if (box[l] >= 0) {
+                    float dir[3] = { dx[l], dy[l], dz[l] };
+                    shade(view, box[l], t[l], dir, out);
+                    depth[idx] = t[l];
+                }
+                else {
+                    out[0] = toByte(SKY_COLOR[0]);
+                    out[1] = toByte(SKY_COLOR[1]);
+                    out[2] = toByte(SKY_COLOR[2]);
+                    depth[idx] = FAR_PLANE;
+                }
+            }
+        }
+    }
+}
+
+// ѩ GL_POINTS + glPointSize(3.0f) ͬ3x3 أܹӰ쵫Ӱ
+void SoftwareRenderer::drawPoints(const View& view) {
+    for (const auto& pt : points) {
+        float v[3] = { pt.x - view.eye[0], pt.y - view.eye[1], pt.z - view.eye[2] };
+        float z = dot3(v, view.forward);
+        if (z < NEAR_PLANE || z > FAR_PLANE) continue;
+
+        float xn = dot3(v, view.side) / (z * view.tanHalfX);
+        float yn = dot3(v, view.up) / (z * view.tanHalfY);
+        float sxf = (xn + 1.0f) * 0.5f * imageWidth;
+        float syf = (1.0f - yn) * 0.5f * imageHeight;
+
+        float fog = fogFactor(z);
+        unsigned char c[3] = {
+            toByte(fog * pt.r + (1.0f - fog) * SKY_COLOR[0]),
+            toByte(fog * pt.g + (1.0f - fog) * SKY_COLOR[1]),
+            toByte(fog * pt.b + (1.0f - fog) * SKY_COLOR[2])
+        };
+
+        int px0 = (int)std::floor(sxf - 1.0f), py0 = (int)std::floor(syf - 1.0f);
+        for (int py = py0; py < py0 + 3; ++py) {
+            if (py < 0 || py >= imageHeight) continue;
+            for (int px = px0; px < px0 + 3; ++px) {
+                if (px < 0 || px >= imageWidth) continue;
+                size_t idx = (size_t)py * imageWidth + px;
+                if (z >= depth[idx]) continue;
+                depth[idx] = z;
+                color[idx * 3 + 0] = c[0];
+                color[idx * 3 + 1] = c[1];
+                color[idx * 3 + 2] = c[2];
+            }
+        }
+    }
+}
+
+void SoftwareRenderer::render(const Camera& camera, JobSystem* jobs) {
+    //  gluLookAt ͬ
+    View view;
+    float up[3] = { camera.upX, camera.upY, camera.upZ };
+    view.eye[0] = camera.eyeX; view.eye[1] = camera.eyeY; view.eye[2] = camera.eyeZ;
+    view.forward[0] = camera.centerX - camera.eyeX;
+    view.forward[1] = camera.centerY - camera.eyeY;
+    view.forward[2] = camera.centerZ - camera.eyeZ;
+    normalize3(view.forward);
+    cross3(view.forward, up, view.side);
+    normalize3(view.side);
+    cross3(view.side, view.forward, view.up);
+
+    //  reshape()  gluPerspective ͬ
+    view.tanHalfY = std::tan(FIELD_OF_VIEW * 0.5f * 3.14159265f / 180.0f);
+    view.tanHalfX = view.tanHalfY * (float)imageWidth / (float)imageHeight;
+
+    // renderScene() ͼ֮ùԴԴ̶ͬ任۾ռ
+    float light[3] = { LIGHT_POSITION[0], LIGHT_POSITION[1], LIGHT_POSITION[2] };
+    view.light[0] = dot3(light, view.side);
+    view.light[1] = dot3(light, view.up);
+    view.light[2] = -dot3(light, view.forward);
+    normalize3(view.light);
+    view.halfVector[0] = view.light[0];
+    view.halfVector[1] = view.light[1];
+    view.halfVector[2] = view.light[2] + 1.0f;
+    normalize3(view.halfVector);
+
+    int tilesX = (imageWidth + TILE_SIZE - 1) / TILE_SIZE;
+    int tilesY = (imageHeight + TILE_SIZE - 1) / TILE_SIZE;
+    auto renderTiles = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            int tx = i % tilesX, ty = i / tilesX;
+            renderTile(view, tx * TILE_SIZE, ty * TILE_SIZE,
+                std::min(imageWidth, (tx + 1) * TILE_SIZE), std::min(imageHeight, (ty + 1) * TILE_SIZE));
+        }
+    };
+
+    if (jobs) {
+        jobs->parallelFor(0, tilesX * tilesY, 1, renderTiles);
+    }
+    else {
+        renderTiles(0, tilesX * tilesY);
+    }
+
+    drawPoints(view);
+}
+
+bool SoftwareRenderer::writeImage(const char* path) const {
+    return writeImagePPM(path, imageWidth, imageHeight, color.data());
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef SOFTWARE_RENDERER_H
+#define SOFTWARE_RENDERER_H
+
+#include <vector>
+#include "VoxelGrid.h"
+
+class Camera;
+class JobSystem;
+
+//  CPU ع߲Ⱦû GPU Ļʹ
+// - Žϡש (VoxelGrid)ÿ 3D DDA 
+// - г 32x32 ͼ飬Ⱦͼ 2x2 Ϊһ߰
+//   ڹߴͬһʱ SIMD һβ 4 
+// - ȡ Camera::applyView + reshape() ͬպ init() ͬ
+class SoftwareRenderer {
+public:
+    SoftwareRenderer(int width, int height);
+
+    // --- ռ÷ display() Ļ˳Ӧ ---
+    void beginScene();
+
+    // ൱ glTranslatef(tx, ty, tz) + glScalef(1, scaleY, 1)֮ӵЧ
+    void setTransform(float tx, float ty, float tz, float scaleY);
+
+    // ൱ drawCube(x, y, z, size, r, g, b)
+    void addVoxel(float x, float y, float z, float size, float r, float g, float b);
+
+    // ܹӰĵ㣨ѩС glPointSize(3.0f) ͬ
+    void addPoint(float x, float y, float z, float r, float g, float b);
+
+    void endScene();
+
+    // Ⱦһ֡jobs Ϊʱ߳Ⱦ
+    void render(const Camera& camera, JobSystem* jobs);
+
+    // Զ PPM ʽд
+    bool writeImage(const char* path) const;
+
+    int width() const { return imageWidth; }
+    int height() const { return imageHeight; }
+    const std::vector<unsigned char>& pixels() const { return color; }
+    size_t boxCount() const { return sceneBoxes.size(); }
+    const VoxelGrid& grid() const { return sceneGrid; }
+
+private:
+    struct Point {
+        float x, y, z;
+        float r, g, b;
+    };
+
+    struct View {
+        float eye[3];
+        float forward[3], side[3], up[3];   //  gluLookAt ͬ
+        float tanHalfY, tanHalfX;
+        float light[3], halfVector[3];      // ۾ռеĹ߷Ͱ
+    };
+
+    void renderTile(const View& view, int x0, int y0, int x1, int y1);
+    void tracePacket(const View& view, const float dx[4], const float dy[4], const float dz[4],
+        int laneMask, int box[4], float t[4]) const;
+    void shade(const View& view, int box, float t, const float dir[3], unsigned char out[3]) const;
+    void drawPoints(const View& view);
+
+    int imageWidth, imageHeight;
+    std::vector<unsigned char> color;   // RGBһ
+    std::vector<float> depth;           // ۾ռȣδΪ FAR_PLANE
+
+    float transform[4];                 // tx, ty, tz, scaleY
+    std::vector<VoxelBox> sceneBoxes;
+    std::vector<Point> points;
+    VoxelGrid sceneGrid;
+};
+
+#endif // SOFTWARE_RENDERER_H
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "StagingRing.h"
+
+#include <cstdio>
+#include <cstring>
+
+StagingRing::StagingRing() : buffer(0), head(0), used(0), frameBytes(0) {}
+
+bool StagingRing::init() {
+    int major = 0, minor = 0;
+    const char* version = (const char*)glGetString(GL_VERSION);
+    if (!version || sscanf(version, "%d.%d", &major, &minor) != 2) return false;
+    if (major * 10 + minor < 32 || !hasStagedUploads()) return false;
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    glBufferData(GL_COPY_READ_BUFFER, SIZE, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    return true;
+}
+
+// ռ䰴Ƚȳգused  [β, head) ĳȣдʱĩβ 0 ʼ
+bool StagingRing::upload(GLuint target, size_t offset, const void* data, size_t bytes) {
+    if (bytes == 0) return true;
+    size_t skip = head + bytes > SIZE ? SIZE - head : 0;
+    if (used + skip + bytes > SIZE) return false;
+
+    size_t start = skip ? 0 : head;
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    void* p = glMapBufferRange(GL_COPY_READ_BUFFER, start, bytes,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (!p) {
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        return false;
+    }
+    memcpy(p, data, bytes);
+    glUnmapBuffer(GL_COPY_READ_BUFFER);
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, target);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, start, offset, bytes);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+    head = start + bytes;
+    used += skip + bytes;
+    frameBytes += skip + bytes;
+    return true;
+}
+
+void StagingRing::retire() {
+    while (!fences.empty()) {
+        GLenum status = glClientWaitSync(fences.front().sync, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) break;
+        glDeleteSync(fences.front().sync);
+        used -= fences.front().bytes;
+        fences.pop_front();
+    }
+    if (used == 0) head = 0;
+}
+
+void StagingRing::endFrame() {
+    if (frameBytes == 0) return;
+    fences.push_back({ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), frameBytes });
+    frameBytes = 0;
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef STAGING_RING_H
+#define STAGING_RING_H
+
+#include <deque>
+#include "GLExt.h"
+
+// ϴõĻݴ滺壺 memcpy ͬӳ䣩 GPU Ŀ껺
+// - ÿ֡һդĿռҪȶӦ֡դɲŻᱻд
+// - դʱʱΪ 0̴߳Ӳȴ GPUʱ upload()  false÷һ֡
+// - Ҫ GL 3.2map range / copy buffer / sync֧ʱ init()  false
+class StagingRing {
+public:
+    static const size_t SIZE = 1 << 20;
+
+    StagingRing();
+
+    bool init();
+    bool ready() const { return buffer != 0; }
+
+    //  data  target  offset bytes  SIZE ռ䲻ʱ false
+    bool upload(GLuint target, size_t offset, const void* data, size_t bytes);
+
+    //  GPU ѾĿռ䣬ÿ֡ʼϴǰ
+    void retire();
+
+    // ֡Ŀ֮դ
+    void endFrame();
+
+    // û GPU ȷϿֽ֡
+    size_t bytesInFlight() const { return used; }
+
+private:
+    struct Fence {
+        GLsync sync;
+        size_t bytes;       // һ֡ռõĻռ䣨ʱβ
+    };
+
+    GLuint buffer;
+    size_t head;            // һдλ
+    size_t used;
+    size_t frameBytes;
+    std::deque<Fence> fences;
+};
+
+#endif // STAGING_RING_H
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "Stats.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+FrameStats g_frameStats = {};
+FrameStats g_lastFrameStats = {};
+FrameTimeHistory g_frameTimes = {};
+MemoryStats g_memoryStats = {};
+LatencyStats g_inputLatency = {};
+StartupStats g_startupStats = { -1.0, -1.0, 0, 0 };
+
+void resetFrameStats() {
+    g_frameStats = FrameStats();
+}
+
+// --- ѷ ---
+// ֻ䣬ͷţÿڴ涼Ҫһͷÿ֡ڷĴ
+
+static std::atomic<long long> g_heapAllocations(0);
+static std::atomic<long long> g_heapBytes(0);
+
+static void* countedAlloc(std::size_t size) {
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    g_heapBytes.fetch_add((long long)size, std::memory_order_relaxed);
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+HeapCounters heapCounters() {
+    HeapCounters c;
+    c.allocations = g_heapAllocations.load(std::memory_order_relaxed);
+    c.bytes = g_heapBytes.load(std::memory_order_relaxed);
+    return c;
+}
+
+// --- ֡ʱ ---
+
+void endFrameStats(double renderMs) {
+    using namespace std::chrono;
+    static double lastEndMs = -1.0;
+    static HeapCounters lastHeap = heapCounters();
+
+    double now = duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+    HeapCounters heap = heapCounters();
+    g_frameStats.heapAllocations = heap.allocations - lastHeap.allocations;
+    g_frameStats.heapBytes = heap.bytes - lastHeap.bytes;
+    lastHeap = heap;
+    g_lastFrameStats = g_frameStats;
+
+    // һ֡ûмԼĺʱ
+    FrameTimeHistory& h = g_frameTimes;
+    h.frameMs[h.next] = (float)(lastEndMs < 0.0 ? renderMs : now - lastEndMs);
+    h.renderMs[h.next] = (float)renderMs;
+    h.next = (h.next + 1) % FRAME_HISTORY;
+    h.count = std::min(h.count + 1, FRAME_HISTORY);
+    lastEndMs = now;
+}
+
+//  i ֡0 ɵģڻλλ
+static int historyIndex(int i) {
+    const FrameTimeHistory& h = g_frameTimes;
+    int oldest = h.count < FRAME_HISTORY ? 0 : h.next;
+    return (oldest + i) % FRAME_HISTORY;
+}
+
+float recentFrameMs(int i) {
+    return g_frameTimes.frameMs[historyIndex(i)];
+}
+
+int frameTimeBucket(float ms) {
+    int b = 0;
+    while (b < FRAME_BUCKETS - 1 && ms > FRAME_BUCKET_LIMITS[b]) ++b;
+    return b;
+}
+
+FrameTimeSummary summarizeFrameTimes() {
+    FrameTimeSummary s = {};
+    const FrameTimeHistory& h = g_frameTimes;
+    if (h.count == 0) return s;
+
+    float sorted[FRAME_HISTORY];
+    double total = 0.0, renderTotal = 0.0;
+    for (int i = 0; i < h.count; ++i) {
+        float ms = h.frameMs[historyIndex(i)];
+        sorted[i] = ms;
+        total += ms;
+        renderTotal += h.renderMs[historyIndex(i)];
+        s.buckets[frameTimeBucket(ms)]++;
+    }
+    std::sort(sorted, sorted + h.count);
+    s.averageMs = (float)(total / h.count);
+    s.p95Ms = sorted[std::min(h.count - 1, (int)(h.count * 0.95f))];
+    s.maxMs = sorted[h.count - 1];
+    s.averageRenderMs = (float)(renderTotal / h.count);
+    return s;
+}
+
+// --- ڴ ---
+
+void addMemoryEntry(const char* name, long long bytes) {
+    MemoryStats& m = g_memoryStats;
+    if (m.count >= MAX_MEMORY_ENTRIES) return;
+    m.names[m.count] = name;
+    m.bytes[m.count] = bytes;
+    m.count++;
+}
+
+void recordInputLatency(double ms) {
+    LatencyStats& l = g_inputLatency;
+    l.samples++;
+    l.lastMs = ms;
+    l.totalMs += ms;
+    if (ms > l.maxMs) l.maxMs = ms;
+}
+
+void printFrameStats(const char* renderPath) {
+    const FrameStats& s = g_frameStats;
+    printf("[%s] draw calls %d, voxels %lld (culled %lld)\n",
+        renderPath, s.drawCalls, s.voxelsSubmitted, s.voxelsCulled);
+    printf("  vertex data %.1f KB/frame, float path %.1f KB/frame",
+        s.vertexBytes / 1024.0, s.floatPathBytes / 1024.0);
+    if (s.vertexBytes > 0) {
+        printf(" (%.1fx)", (double)s.floatPathBytes / (double)s.vertexBytes);
+    }
+    printf("\n");
+    printf("  scene nodes updated %d, matrix uploads %d\n", s.nodesUpdated, s.matrixUploads);
+    printf("  lit vertices %lld, baked (unlit) vertices %lld\n", s.litVertices, s.bakedVertices);
+    if (s.uploadBytes > 0) printf("  uploaded %.1f KB this frame\n", s.uploadBytes / 1024.0);
+    printf("  heap %lld allocations (%.1f KB) last frame\n", g_lastFrameStats.heapAllocations,
+        g_lastFrameStats.heapBytes / 1024.0);
+    if (s.renderScale > 0.0f) {
+        printf("  render resolution %dx%d (%.0f%%)", s.renderWidth, s.renderHeight, s.renderScale * 100.0f);
+        if (s.controlMs >= 0.0f) printf(", smoothed frame %.1f ms", s.controlMs);
+        if (s.targetMs > 0.0f) printf(", target %.1f ms\n", s.targetMs);
+        else printf(", dynamic resolution off\n");
+    }
+
+    FrameTimeSummary ft = summarizeFrameTimes();
+    if (g_frameTimes.count > 0) {
+        printf("  frame time avg %.1f ms, p95 %.1f, max %.1f (render %.1f ms) over %d frames\n",
+            ft.averageMs, ft.p95Ms, ft.maxMs, ft.averageRenderMs, g_frameTimes.count);
+    }
+    const MemoryStats& m = g_memoryStats;
+    if (m.count > 0) {
+        printf("  memory:");
+        for (int i = 0; i < m.count; ++i) printf(" %s %.1f KB%s", m.names[i], m.bytes[i] / 1024.0, i + 1 < m.count ? "," : "");
+        printf("; GPU buffers %.1f KB\n", m.gpuBytes / 1024.0);
+    }
+
+    const LatencyStats& l = g_inputLatency;
+    if (l.samples > 0) {
+        printf("  input to photon %.1f ms (avg %.1f, max %.1f over %d events)\n",
+            l.lastMs, l.totalMs / l.samples, l.maxMs, l.samples);
+    }
+    printStartupStats();
+}
+
+void printStartupStats() {
+    const StartupStats& st = g_startupStats;
+    if (st.firstFrameMs < 0.0) return;
+    printf("  time to first frame %.1f ms", st.firstFrameMs);
+    if (st.loadedMs >= 0.0) {
+        printf(", fully loaded %.1f ms (%d frames drawn while loading, %.1f KB uploaded)\n",
+            st.loadedMs, st.framesWhileLoading, st.uploadedBytes / 1024.0);
+    } else {
+        printf(", still loading (%d frames so far)\n", st.framesWhileLoading);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#ifndef STATS_H
+#define STATS_H
+
+// ÿ֡Ⱦͳƣdisplay() ͷ㣬·ۼ
+struct FrameStats {
+    int drawCalls;                  // glDrawArrays / glutSolidCube ô
+    long long voxelsSubmitted;      //  GPU 
+    long long voxelsCulled;         // ׶޳
+    long long vertexBytes;          // ֡ʵʶȡĶ/ʵ
+    long long floatPathBytes;       // ͬȫ drawCube ҪԱã
+    int nodesUpdated;               // ͼĽڵ
+    int matrixUploads;              // glLoadMatrixf 
+    long long litVertices;          // Ҫ𶥵յĶ
+    long long bakedVertices;        // Ѻ決ɫռĶ
+    long long uploadBytes;          // ֡ϴд GPU ֽ
+    long long heapAllocations;      // ֡Ķѷ̣߳endFrameStats д
+    long long heapBytes;            // ֡ѷֽ
+    float renderScale;              // ֱ̬ʵţdisplay() д׼ֱӻʱΪ 0
+    int renderWidth, renderHeight;  // ʵʵȾֱ
+    float controlMs;                // ֱ̬ʿ֡ʱƽ󣩣< 0 ʾû
+    float targetMs;                 // Ŀ꣬0 ʾֱ̬ʹر
+};
+
+extern FrameStats g_frameStats;
+extern FrameStats g_lastFrameStats; // һ֡HUD ͻ׼Զݣһ֡
+
+// ѷStats.cpp 滻ȫֵ operator newеķ䶼
+struct HeapCounters {
+    long long allocations;
+    long long bytes;
+};
+
+HeapCounters heapCounters();
+
+//  FRAME_HISTORY ֡֡ʱ䣨룩
+// frameMs ֡ļʵ֡ʣrenderMs  display() ĺʱ
+const int FRAME_HISTORY = 240;
+
+struct FrameTimeHistory {
+    float frameMs[FRAME_HISTORY];   // λ壬next ָɵһ֡
+    float renderMs[FRAME_HISTORY];
+    int next;
+    int count;
+};
+
+extern FrameTimeHistory g_frameTimes;
+
+// ֡ʱֲķֵޣ룩һǳ FRAME_BUCKET_LIMITS ֵ֡
+const int FRAME_BUCKETS = 5;
+const float FRAME_BUCKET_LIMITS[FRAME_BUCKETS - 1] = { 8.0f, 16.7f, 33.3f, 50.0f };
+
+//  count ֡ķֲͳƣûм¼ʱȫΪ 0
+struct FrameTimeSummary {
+    int buckets[FRAME_BUCKETS];
+    float averageMs;
+    float p95Ms;
+    float maxMs;
+    float averageRenderMs;
+};
+
+FrameTimeSummary summarizeFrameTimes();
+
+// ֡ʱڵĵ
+int frameTimeBucket(float ms);
+
+//  i ֡0 ɵģ
+float recentFrameMs(int i);
+
+// һ֮֡󣩣¼֡ʱ䡢֡Ķѷ䣬 g_frameStats  g_lastFrameStats
+void endFrameStats(double renderMs);
+
+// ģ CPU ռõڴ GPU main.cpp  updateMemoryStats() д
+const int MAX_MEMORY_ENTRIES = 12;
+
+struct MemoryStats {
+    const char* names[MAX_MEMORY_ENTRIES];
+    long long bytes[MAX_MEMORY_ENTRIES];
+    int count;
+    long long gpuBytes;
+};
+
+extern MemoryStats g_memoryStats;
+
+void addMemoryEntry(const char* name, long long bytes);
+
+// 뵽ӳ٣ص  ðһ֡岢ִ
+struct LatencyStats {
+    int samples;
+    double lastMs;
+    double totalMs;
+    double maxMs;
+};
+
+extern LatencyStats g_inputLatency;
+
+void recordInputLatency(double ms);
+
+// ʱ䣨룬 main() ʼ㣩ﻭһ֡ģɲϴ
+struct StartupStats {
+    double firstFrameMs;            // < 0 ʾûлһ֡
+    double loadedMs;                // < 0 ʾڼ
+    int framesWhileLoading;         // ֮ǰѾ֡
+    long long uploadedBytes;        // ϴд GPU ֽ
+};
+
+extern StartupStats g_startupStats;
+
+void printStartupStats();
+
+// glutSolidCube ÿύ 24 㣨λ + ߸ 3  floatһɫ
+const long long FLOAT_CUBE_BYTES = 24 * 6 * sizeof(float) + 3 * sizeof(float);
+
+void resetFrameStats();
+
+// ӡǰ֡ͳƺӳ٣ 'i' 
+void printFrameStats(const char* renderPath);
+
+#endif // STATS_H
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include "StatsHud.h"
+
+#include <GL/glut.h>
+#include <algorithm>
+#include <cstdio>
+#include "Stats.h"
+
+static const int HUD_MARGIN = 10;
+static const int HUD_PADDING = 8;
+static const int LINE_HEIGHT = 15;
+static const int HUD_WIDTH = 460;
+static const int GRAPH_HEIGHT = 60;
+static const float GRAPH_MAX_MS = 50.0f;    // ߵ᷶Χ֡ڶ
+static const int BUCKET_BAR_WIDTH = 200;
+
+static void hudText(int x, int y, const char* text) {
+    glRasterPos2i(x, y);
+    for (const char* c = text; *c; ++c) glutBitmapCharacter(GLUT_BITMAP_8_BY_13, *c);
+}
+
+static void hudRect(float x0, float y0, float x1, float y1) {
+    glVertex2f(x0, y0);
+    glVertex2f(x1, y0);
+    glVertex2f(x1, y1);
+    glVertex2f(x0, y1);
+}
+
+// ֡ʱĵɫɫ 60 fps Ԥڣɫ30 fps ڣɫ
+static void bucketColor(int bucket) {
+    if (bucket <= 1) glColor3f(0.3f, 0.9f, 0.3f);
+    else if (bucket == 2) glColor3f(0.95f, 0.8f, 0.2f);
+    else glColor3f(0.95f, 0.3f, 0.25f);
+}
+
+void drawStatsHud(const char* renderPath) {
+    const FrameStats& s = g_lastFrameStats;
+    const MemoryStats& m = g_memoryStats;
+    FrameTimeSummary ft = summarizeFrameTimes();
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_COLOR_BUFFER_BIT);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_FOG);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_TEXTURE_2D);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // ꣬ԭϽ
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0.0, viewport[2], viewport[3], 0.0, -1.0, 1.0);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    const int textLines = 6 + m.count + 1 + FRAME_BUCKETS;
+    const int left = HUD_MARGIN + HUD_PADDING;
+    const int top = HUD_MARGIN + HUD_PADDING;
+    const int graphTop = top + 6 * LINE_HEIGHT + 4;
+    const int height = textLines * LINE_HEIGHT + GRAPH_HEIGHT + 2 * HUD_PADDING + 12;
+
+    glBegin(GL_QUADS);
+    glColor4f(0.0f, 0.0f, 0.0f, 0.6f);
+    hudRect((float)HUD_MARGIN, (float)HUD_MARGIN, (float)(HUD_MARGIN + HUD_WIDTH), (float)(HUD_MARGIN + height));
+    glEnd();
+
+    char line[160];
+    int y = top + LINE_HEIGHT - 3; // λͼĻ
+    glColor3f(1.0f, 1.0f, 1.0f);
+    snprintf(line, sizeof(line), "[%s] %.1f fps  frame %.1f ms  p95 %.1f  max %.1f", renderPath,
+        ft.averageMs > 0.0f ? 1000.0f / ft.averageMs : 0.0f, ft.averageMs, ft.p95Ms, ft.maxMs);
+    hudText(left, y, line);
+    y += LINE_HEIGHT;
+    snprintf(line, sizeof(line), "render %.1f ms  draw calls %d", ft.averageRenderMs, s.drawCalls);
+    hudText(left, y, line);
+    y += LINE_HEIGHT;
+    snprintf(line, sizeof(line), "voxels %lld submitted, %lld culled", s.voxelsSubmitted, s.voxelsCulled);
+    hudText(left, y, line);
+    y += LINE_HEIGHT;
+    snprintf(line, sizeof(line), "heap %lld allocs (%.1f KB) per frame", s.heapAllocations, s.heapBytes / 1024.0);
+    hudText(left, y, line);
+    y += LINE_HEIGHT;
+    snprintf(line, sizeof(line), "GPU buffers %.1f KB", m.gpuBytes / 1024.0);
+    hudText(left, y, line);
+    y += LINE_HEIGHT;
+    // ֱ̬ʣʵʵȾֱʺͿ֡ʱ
+    if (s.targetMs > 0.0f) {
+        snprintf(line, sizeof(line), "resolution %dx%d (%.0f%%)  frame %.1f / %.1f ms", s.renderWidth, s.renderHeight,
+            s.renderScale * 100.0f, s.controlMs < 0.0f ? 0.0f : s.controlMs, s.targetMs);
+    } else {
+        snprintf(line, sizeof(line), "resolution %dx%d (dynamic off)", s.renderWidth, s.renderHeight);
+    }
+    hudText(left, y, line);
+
+    // ֡ʱߣÿ֡ 1 ؿµұ
+    const int graphWidth = FRAME_HISTORY;
+    const float msToPixels = GRAPH_HEIGHT / GRAPH_MAX_MS;
+    const float graphBottom = (float)(graphTop + GRAPH_HEIGHT);
+    glBegin(GL_QUADS);
+    glColor4f(1.0f, 1.0f, 1.0f, 0.08f);
+    hudRect((float)left, (float)graphTop, (float)(left + graphWidth), graphBottom);
+    int first = graphWidth - g_frameTimes.count;
+    for (int i = 0; i < g_frameTimes.count; ++i) {
+        float ms = recentFrameMs(i);
+        float x = (float)(left + first + i);
+        bucketColor(frameTimeBucket(ms));
+        hudRect(x, graphBottom - std::min(ms, GRAPH_MAX_MS) * msToPixels, x + 1.0f, graphBottom);
+    }
+    glEnd();
+    glBegin(GL_LINES);
+    glColor4f(1.0f, 1.0f, 1.0f, 0.5f);
+    for (int b = 1; b <= 2; ++b) {
+        float ly = graphBottom - FRAME_BUCKET_LIMITS[b] * msToPixels;
+        glVertex2f((float)left, ly);
+        glVertex2f((float)(left + graphWidth), ly);
+    }
+    glEnd();
+
+    // ֲÿһУĳȰ֡
+    y = graphTop + GRAPH_HEIGHT + 4 + LINE_HEIGHT - 3;
+    glColor3f(1.0f, 1.0f, 1.0f);
+    for (int b = 0; b < FRAME_BUCKETS; ++b) {
+        if (b == 0) snprintf(line, sizeof(line), "   < %4.1f ms %3d", FRAME_BUCKET_LIMITS[0], ft.buckets[b]);
+        else if (b < FRAME_BUCKETS - 1) snprintf(line, sizeof(line), "%4.1f-%4.1f ms %3d", FRAME_BUCKET_LIMITS[b - 1], FRAME_BUCKET_LIMITS[b], ft.buckets[b]);
+        else snprintf(line, sizeof(line), "   > %4.1f ms %3d", FRAME_BUCKET_LIMITS[b - 1], ft.buckets[b]);
+        hudText(left, y, line);
+        y += LINE_HEIGHT;
+    }
+    int barLeft = left + 18 * 8;
+    int barTop = graphTop + GRAPH_HEIGHT + 4 + 2;
+    glBegin(GL_QUADS);
+    for (int b = 0; b < FRAME_BUCKETS; ++b) {
+        if (g_frameTimes.count == 0) break;
+        float w = (float)BUCKET_BAR_WIDTH * ft.buckets[b] / g_frameTimes.count;
+        bucketColor(b);
+        float by = (float)(barTop + b * LINE_HEIGHT);
+        hudRect((float)barLeft, by, barLeft + w, by + LINE_HEIGHT - 4.0f);
+    }
+    glEnd();
+
+    // ģ͵ڴ
+    glColor3f(1.0f, 1.0f, 1.0f);
+    y += 4;
+    hudText(left, y, "model memory");
+    y += LINE_HEIGHT;
+    for (int i = 0; i < m.count; ++i) {
+        snprintf(line, sizeof(line), "  %-10s %9.1f KB", m.names[i], m.bytes[i] / 1024.0);
+        hudText(left, y, line);
+        y += LINE_HEIGHT;
+    }
+
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopAttrib();
+}
\ No newline at end of file
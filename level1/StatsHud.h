@@ -0,0 +1,13 @@
+#ifndef STATS_HUD_H
+#define STATS_HUD_H
+
+// ʱͳƵĸǲ㣨 'h' أڳ֮ϡ֮ǰ
+// -  FRAME_HISTORY ֡֡ʱߣ16.7 / 33.3 ms οߣͷֲֵ
+// - һ֡ĻƵáύ / ޳ءѷֽ
+// - ֱ̬ʵȾֱʡź֡ʱ
+// - ģռõڴ GPU 
+// ȫ Stats.h ȫͳƣ׼ֱӶͬһݣֻ𻭣
+// ̶ + GLUT λͼ壬ʱ򲻷ڴ棬ӰԼʾķ
+void drawStatsHud(const char* renderPath);
+
+#endif // STATS_HUD_H
\ No newline at end of file
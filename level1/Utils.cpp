@@ -1,4 +1,6 @@
 #include "Utils.h"
+#include "Stats.h"
+#include <cstdio>
 
 // ʵ
 // ʹglPushMatrix/glPopMatrixȷı任ƶӰ쵽е
@@ -9,4 +11,56 @@ void drawCube(float x, float y, float z, float size, float r, float g, float b)
     glutSolidCube(size);      // ʹGLUTúһʵ
     // ֶglBegin/glEndҪ򵥸Ч
     glPopMatrix();
+
+    g_frameStats.drawCalls++;
+    g_frameStats.voxelsSubmitted++;
+    g_frameStats.vertexBytes += FLOAT_CUBE_BYTES;
+    g_frameStats.floatPathBytes += FLOAT_CUBE_BYTES;
+    g_frameStats.litVertices += 24;
+}
+
+//  ͶӰ * ģͼ ϳüƽ棺ҡϡԶ
+void currentFrustumPlanes(float planes[6][4]) {
+    float mv[16], proj[16], m[16];
+    glGetFloatv(GL_MODELVIEW_MATRIX, mv);
+    glGetFloatv(GL_PROJECTION_MATRIX, proj);
+    for (int c = 0; c < 4; ++c) {
+        for (int r = 0; r < 4; ++r) {
+            m[c * 4 + r] = proj[r] * mv[c * 4] + proj[4 + r] * mv[c * 4 + 1] +
+                proj[8 + r] * mv[c * 4 + 2] + proj[12 + r] * mv[c * 4 + 3];
+        }
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        for (int k = 0; k < 4; ++k) {
+            planes[i * 2][k] = m[k * 4 + 3] + m[k * 4 + i];
+            planes[i * 2 + 1][k] = m[k * 4 + 3] - m[k * 4 + i];
+        }
+    }
+}
+
+bool writeImagePPM(const char* path, int width, int height, const unsigned char* rgb) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+
+    fprintf(f, "P6\n%d %d\n255\n", width, height);
+    size_t bytes = (size_t)width * height * 3;
+    bool ok = fwrite(rgb, 1, bytes, f) == bytes;
+    fclose(f);
+    return ok;
+}
+
+bool readImagePPM(const char* path, int& width, int& height, std::vector<unsigned char>& rgb) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+
+    int maxValue = 0;
+    bool ok = fscanf(f, "P6 %d %d %d", &width, &height, &maxValue) == 3 && maxValue == 255 &&
+        width > 0 && height > 0 && fgetc(f) != EOF; // ͷһհַ
+    if (ok) {
+        rgb.resize((size_t)width * height * 3);
+        ok = fread(rgb.data(), 1, rgb.size(), f) == rgb.size();
+    }
+    fclose(f);
+    return ok;
 }
\ No newline at end of file
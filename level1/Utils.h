@@ -2,8 +2,18 @@
 #define UTILS_H
 
 #include <GL/glut.h> // GLUT
+#include <vector>
 
 // һָλûһɫ
 void drawCube(float x, float y, float z, float size, float r, float g, float b);
 
+// ӵǰͶӰ * ģͼȡ 6 üƽ (a, b, c, d)߳ڣδһ
+void currentFrustumPlanes(float planes[6][4]);
+
+//  RGB ͼ񣨵һϣдɶ PPM ļ
+bool writeImagePPM(const char* path, int width, int height, const unsigned char* rgb);
+
+// ȡ writeImagePPM дļP6ֵ 255ʧܷ false
+bool readImagePPM(const char* path, int& width, int& height, std::vector<unsigned char>& rgb);
+
 #endif // UTILS_H
\ No newline at end of file
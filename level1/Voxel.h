@@ -1,6 +1,8 @@
 #ifndef VOXEL_H
 #define VOXEL_H
 
+#include <cstddef>
+
 // ͨ (1.0f)
 struct Voxel {
     float x, y, z;
@@ -25,4 +27,17 @@ struct VoxelName {
     float r, g, b;
 };
 
+// ָһݵֻͼں決ģͨģ飩
+template <class T>
+struct VoxelSpan {
+    const T* first = nullptr;
+    size_t count = 0;
+
+    const T* begin() const { return first; }
+    const T* end() const { return first + count; }
+    const T* data() const { return first; }
+    size_t size() const { return count; }
+    const T& operator[](size_t i) const { return first[i]; }
+};
+
 #endif // VOXEL_H
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "VoxelFont.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+
+// εÿһλλ󣬴¹ GLYPH_VOXEL_ROWS 
+// left һĵ xΪλĸΪ 0width 
+const int GLYPH_VOXEL_ROWS = 21;
+
+struct GlyphBitmap {
+    int left;
+    int width;
+    unsigned int rows[GLYPH_VOXEL_ROWS];
+};
+
+// L / Y / T ԭֹƵֱͣӴɵ
+struct FineGlyph {
+    char ch;
+    GlyphBitmap bitmap;
+};
+
+static const FineGlyph FINE_GLYPHS[] = {
+    { 'L', { -2, 13, {
+        0x01F00, 0x01F00, 0x01F00, 0x01F00, 0x01F00, 0x01F00, 0x01F00, 0x01F00, 0x01F00, 0x01F00, 0x01F00,
+        0x01F00, 0x01F00, 0x01F00, 0x01F00, 0x01F00, 0x01FFF, 0x01FFF, 0x01FFF, 0x01FFF, 0x01FFF } } },
+    { 'Y', { -8, 17, {
+        0x1F01F, 0x0F83E, 0x0F83E, 0x07C7C, 0x07C7C, 0x03EF8, 0x01FF0, 0x01FF0, 0x00FE0, 0x00FE0, 0x007C0,
+        0x007C0, 0x007C0, 0x007C0, 0x007C0, 0x007C0, 0x007C0, 0x007C0, 0x007C0, 0x007C0, 0x007C0 } } },
+    { 'T', { -8, 17, {
+        0x1FFFF, 0x1FFFF, 0x1FFFF, 0x1FFFF, 0x1FFFF, 0x007C0, 0x007C0, 0x007C0, 0x007C0, 0x007C0, 0x007C0,
+        0x007C0, 0x007C0, 0x007C0, 0x007C0, 0x007C0, 0x007C0, 0x007C0, 0x007C0, 0x007C0, 0x007C0 } } }
+};
+
+// ĸ 5x7 ÿе 5 λλ󣩣ÿŴ 3x3 
+struct CoarseGlyph {
+    char ch;
+    unsigned char rows[7];
+};
+
+static const CoarseGlyph COARSE_GLYPHS[] = {
+    { 'A', { 0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 } },
+    { 'B', { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E } },
+    { 'C', { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E } },
+    { 'D', { 0x1E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1E } },
+    { 'E', { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F } },
+    { 'F', { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 } },
+    { 'G', { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F } },
+    { 'H', { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 } },
+    { 'I', { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+    { 'J', { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C } },
+    { 'K', { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 } },
+    { 'M', { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 } },
+    { 'N', { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 } },
+    { 'O', { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E } },
+    { 'P', { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 } },
+    { 'Q', { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D } },
+    { 'R', { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 } },
+    { 'S', { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E } },
+    { 'U', { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E } },
+    { 'V', { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 } },
+    { 'W', { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A } },
+    { 'X', { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 } },
+    { 'Z', { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F } },
+    { '0', { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E } },
+    { '1', { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+    { '2', { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F } },
+    { '3', { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E } },
+    { '4', { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 } },
+    { '5', { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E } },
+    { '6', { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E } },
+    { '7', { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 } },
+    { '8', { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E } },
+    { '9', { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C } }
+};
+
+// ַĵ󣬲ֵַ֧ false
+static bool glyphBitmap(char ch, GlyphBitmap& out) {
+    for (const FineGlyph& glyph : FINE_GLYPHS) {
+        if (glyph.ch == ch) {
+            out = glyph.bitmap;
+            return true;
+        }
+    }
+    for (const CoarseGlyph& glyph : COARSE_GLYPHS) {
+        if (glyph.ch != ch) continue;
+        // 5 зŴ 15 Уڵ 8 У L / Y / T ĸ߶ͬ 21 У
+        out.left = -7;
+        out.width = 15;
+        for (int row = 0; row < GLYPH_VOXEL_ROWS; ++row) {
+            unsigned int bits = 0;
+            for (int col = 0; col < 5; ++col) {
+                if (glyph.rows[row / 3] & (0x10 >> col)) bits |= 0x7u << (3 * (4 - col));
+            }
+            out.rows[row] = bits;
+        }
+        return true;
+    }
+    return false;
+}
+
+// εأֵַ֧ false
+static bool rasterizeGlyph(char ch, std::vector<GlyphVoxel>& out) {
+    GlyphBitmap bitmap;
+    if (!glyphBitmap(ch, bitmap)) return false;
+    for (int col = 0; col < bitmap.width; ++col) {
+        float x = (bitmap.left + col) * GLYPH_VOXEL_SIZE;
+        for (int row = GLYPH_VOXEL_ROWS - 1; row >= 0; --row) {
+            if (!(bitmap.rows[row] & (1u << (bitmap.width - 1 - col)))) continue;
+            float y = (GLYPH_VOXEL_ROWS - 1 - row) * GLYPH_VOXEL_SIZE;
+            for (float z = 0.0f; z <= GLYPH_THICKNESS; z += GLYPH_VOXEL_SIZE) out.push_back({ x, y, z });
+        }
+    }
+    return true;
+}
+
+static std::mutex g_glyphLock;
+static std::map<char, std::unique_ptr<VoxelGlyph>> g_glyphs;   // ֵַָ֧
+
+// ÷ g_glyphLock
+static VoxelGlyph* findGlyph(char ch) {
+    auto it = g_glyphs.find(ch);
+    if (it != g_glyphs.end()) return it->second.get();
+
+    std::unique_ptr<VoxelGlyph> glyph(new VoxelGlyph());
+    glyph->ch = ch;
+    if (!rasterizeGlyph(ch, glyph->voxels)) glyph.reset();
+    VoxelGlyph* result = glyph.get();
+    g_glyphs[ch] = std::move(glyph);
+    return result;
+}
+
+const VoxelGlyph* voxelGlyph(char ch) {
+    std::lock_guard<std::mutex> guard(g_glyphLock);
+    return findGlyph(ch);
+}
+
+const std::vector<GlyphVertex>& voxelGlyphMesh(char ch, const LightBake& bake) {
+    static const std::vector<GlyphVertex> EMPTY;
+    std::lock_guard<std::mutex> guard(g_glyphLock);
+    VoxelGlyph* glyph = findGlyph(ch);
+    if (!glyph) return EMPTY;
+    if (!glyph->meshed) {
+        glyph->mesh = buildGlyphMesh(glyph->voxels.data(), glyph->voxels.size(), GLYPH_VOXEL_SIZE, bake);
+        glyph->meshed = true;
+    }
+    return glyph->mesh;
+}
+
+bool layoutText(const std::string& text, float originX, float advance, std::vector<GlyphPlacement>& out,
+    char* bad) {
+    std::vector<GlyphPlacement> placed;
+    GlyphBitmap bitmap;
+    for (size_t i = 0; i < text.size(); ++i) {
+        char ch = (char)toupper((unsigned char)text[i]);
+        if (ch == ' ') continue;
+        if (!glyphBitmap(ch, bitmap)) {
+            if (bad) *bad = text[i];
+            return false;
+        }
+        placed.push_back({ ch, originX + advance * (float)i });
+    }
+    out.swap(placed);
+    return true;
+}
+
+size_t voxelFontBytes() {
+    std::lock_guard<std::mutex> guard(g_glyphLock);
+    size_t bytes = 0;
+    for (const auto& entry : g_glyphs) {
+        if (!entry.second) continue;
+        bytes += sizeof(VoxelGlyph) + entry.second->voxels.capacity() * sizeof(GlyphVoxel) +
+            entry.second->mesh.capacity() * sizeof(GlyphVertex);
+    }
+    return bytes;
+}
+
+// x - floor(x / 289) * 289 GLSL  mod(x, 289.0) ͬ
+static float mod289(float x) {
+    return x - std::floor(x / 289.0f) * 289.0f;
+}
+
+static float permute(float x) {
+    return mod289((34.0f * x + 1.0f) * x);
+}
+
+float glyphDither(float x, float y, float z) {
+    // ÿ permute ֮ǰȡģ˻ 34 * 289 * 289float Ծȷʾ
+    float h = permute(mod289(std::floor(x * 4.0f + 0.5f)));
+    h = permute(mod289(h + mod289(std::floor(y * 4.0f + 0.5f))));
+    h = permute(mod289(h + mod289(std::floor(z * 4.0f + 0.5f))));
+    return h / 289.0f;
+}
+
+void glyphShade(const float base[3], float x, float y, float z, float depth, float out[3]) {
+    // ͵ĸ߶Ƚ (1.0 -> 1.6)㷽ɫС
+    float heightFactor = 1.0f + 0.6f * (y / GLYPH_HEIGHT);
+    // Ƚ䣺ò治Ҫ̫ڣһͨ͸
+    float depthFactor = 0.5f + 0.5f * (depth / GLYPH_THICKNESS);
+    // -0.03  +0.03 ĺƣпеĥɰ
+    float noise = (glyphDither(x, y, z) - 0.5f) * 0.06f;
+    float factor = heightFactor * depthFactor + noise;
+
+    // sqrt ɫӳȣٽضϵ [0, 1]
+    for (int a = 0; a < 3; ++a) out[a] = std::min(std::sqrt(std::max(base[a] * factor, 0.0f)), 1.0f);
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#ifndef VOXEL_FONT_H
+#define VOXEL_FONT_H
+
+#include <string>
+#include <vector>
+#include "VoxelMesh.h"
+
+// 壺ַդ 0.25 Σģã
+// - ζɵL / Y / T ش棨ԭͣ A-Z0-9  5x7 ÿ 3x3 
+// - ꣺x ĸΪ 0y  0  GLYPH_HEIGHTz  0  GLYPH_THICKNESS0 Ӧļֵ z
+// - ÿֻɡһβ棬ظĸͬһGPU ϰʵƣ
+// - ɫֻȡĸĻλãglyphShadeɫͬʵ֣
+//   ԻһֲҪκص CPU عԣ--bench regression  glyphs һУ
+//   ӹյطֱκ drawCube չ֣֤ߵɫһ
+
+const float GLYPH_VOXEL_SIZE = 0.25f;
+const float GLYPH_THICKNESS = 0.5f;
+const float GLYPH_HEIGHT = 5.0f;
+
+struct GlyphVoxel {
+    float x, y, z;
+};
+
+struct VoxelGlyph {
+    char ch;
+    std::vector<GlyphVoxel> voxels;
+    std::vector<GlyphVertex> mesh;  // voxelGlyphMesh() һõʱ
+    bool meshed = false;
+};
+
+// ַΣһõʱɣֵַ֧ nullptr̰߳ȫصָһֱЧ
+const VoxelGlyph* voxelGlyph(char ch);
+
+// εbuildGlyphMeshһεʱ bake ɲ棨ǳ
+// ֵַ֧ؿ̰߳ȫ
+const std::vector<GlyphVertex>& voxelGlyphMesh(char ch, const LightBake& bake);
+
+// źõһַx ĸ
+struct GlyphPlacement {
+    char ch;
+    float x;
+};
+
+// һųַλãһַ originX֮ÿַ advance
+// Сдĸתɴдոֻռλòֵַ֧ falsebad Ǹַ
+bool layoutText(const std::string& text, float originX, float advance, std::vector<GlyphPlacement>& out,
+    char* bad = nullptr);
+
+// λռõڴ棨غ
+size_t voxelFontBytes();
+
+// λõȷԶ [0, 1)İ 1/4 ȡ permute-289 ϣ
+// ֻ 2^24 ڵ㣬GLSL  float Ҳܾȷʾɫͬʵ֣
+float glyphDither(float x, float y, float z);
+
+// صɫ߶Ƚ * Ƚ +  sqrt ɫӳ
+// (x, y, z) µλãdepth  z (0  GLYPH_THICKNESS)
+void glyphShade(const float base[3], float x, float y, float z, float depth, float out[3]);
+
+#endif // VOXEL_FONT_H
\ No newline at end of file
@@ -0,0 +1,313 @@
+#include "VoxelGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+// ӱ߽غʱݲ 1.0 ϵķ鱻ڸ
+static const float CELL_EPS = 1e-4f;
+
+VoxelGrid::VoxelGrid() {
+    clear();
+}
+
+void VoxelGrid::clear() {
+    cell = 1.0f;
+    for (int a = 0; a < 3; ++a) {
+        gridOrigin[a] = 0.0f;
+        cellDims[a] = 0;
+        brickDims[a] = 0;
+    }
+    boxList.clear();
+    topLevel.clear();
+    bricks.clear();
+    cellBoxList.clear();
+}
+
+void VoxelGrid::build(const std::vector<VoxelBox>& boxes, float cellSize) {
+    clear();
+    if (boxes.empty()) return;
+
+    cell = cellSize;
+    boxList = boxes;
+
+    // 1. ΧУ뵽 (k + 0.5) * cell
+    float lo[3] = { 1e30f, 1e30f, 1e30f };
+    float hi[3] = { -1e30f, -1e30f, -1e30f };
+    for (const auto& b : boxList) {
+        for (int a = 0; a < 3; ++a) {
+            lo[a] = std::min(lo[a], b.min[a]);
+            hi[a] = std::max(hi[a], b.max[a]);
+        }
+    }
+    for (int a = 0; a < 3; ++a) {
+        gridOrigin[a] = (std::floor(lo[a] / cell - 0.5f) + 0.5f) * cell;
+        cellDims[a] = (int)std::ceil((hi[a] - gridOrigin[a]) / cell) + 1;
+        brickDims[a] = (cellDims[a] + BRICK - 1) / BRICK;
+        cellDims[a] = brickDims[a] * BRICK;
+    }
+
+    // 2.  (ש, , ) Ԫ鲢
+    std::vector<uint64_t> keys;
+    keys.reserve(boxList.size() * 2);
+    for (uint32_t i = 0; i < (uint32_t)boxList.size(); ++i) {
+        const VoxelBox& b = boxList[i];
+        int c0[3], c1[3];
+        for (int a = 0; a < 3; ++a) {
+            c0[a] = (int)std::floor((b.min[a] - gridOrigin[a]) / cell + CELL_EPS);
+            c1[a] = (int)std::floor((b.max[a] - gridOrigin[a]) / cell - CELL_EPS);
+            c0[a] = std::max(0, std::min(cellDims[a] - 1, c0[a]));
+            c1[a] = std::max(c0[a], std::min(cellDims[a] - 1, c1[a]));
+        }
+        for (int z = c0[2]; z <= c1[2]; ++z) {
+            for (int y = c0[1]; y <= c1[1]; ++y) {
+                for (int x = c0[0]; x <= c1[0]; ++x) {
+                    uint64_t brick = (uint64_t)((x >> 2) + brickDims[0] * ((y >> 2) + brickDims[1] * (z >> 2)));
+                    uint64_t key = ((brick * 64 + (uint64_t)localIndex(x, y, z)) << 32) | i;
+                    keys.push_back(key);
+                }
+            }
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+
+    // 3. ˳ש
+    topLevel.assign((size_t)brickDims[0] * brickDims[1] * brickDims[2], -1);
+    cellBoxList.resize(keys.size());
+
+    size_t k = 0;
+    while (k < keys.size()) {
+        uint64_t brickId = (keys[k] >> 32) / 64;
+        topLevel[(size_t)brickId] = (int)bricks.size();
+
+        Brick brick;
+        brick.occupancy = 0;
+        for (int c = 0; c < 64; ++c) {
+            brick.first[c] = (uint32_t)k;
+            while (k < keys.size() && (keys[k] >> 32) == brickId * 64 + (uint64_t)c) {
+                cellBoxList[k] = (uint32_t)(keys[k] & 0xffffffffu);
+                ++k;
+            }
+            if (brick.first[c] != (uint32_t)k) brick.occupancy |= (uint64_t)1 << c;
+        }
+        brick.first[64] = (uint32_t)k;
+        bricks.push_back(brick);
+    }
+}
+
+const VoxelGrid::Brick* VoxelGrid::brickAt(int cx, int cy, int cz) const {
+    if (cx < 0 || cy < 0 || cz < 0 || cx >= cellDims[0] || cy >= cellDims[1] || cz >= cellDims[2]) {
+        return nullptr;
+    }
+    int idx = topLevel[(cx >> 2) + brickDims[0] * ((cy >> 2) + brickDims[1] * (cz >> 2))];
+    return idx < 0 ? nullptr : &bricks[idx];
+}
+
+size_t VoxelGrid::memoryBytes() const {
+    return boxList.capacity() * sizeof(VoxelBox) +
+        topLevel.capacity() * sizeof(int) +
+        bricks.capacity() * sizeof(Brick) +
+        cellBoxList.capacity() * sizeof(uint32_t);
+}
+
+bool VoxelGrid::intersectBox(const VoxelBox& box, const float origin[3], const float invDir[3],
+    float tMin, float tMax, float& t) {
+    float tNear = -1e30f, tFar = 1e30f;
+    for (int a = 0; a < 3; ++a) {
+        float t1 = (box.min[a] - origin[a]) * invDir[a];
+        float t2 = (box.max[a] - origin[a]) * invDir[a];
+        if (t1 > t2) std::swap(t1, t2);
+        tNear = std::max(tNear, t1);
+        tFar = std::min(tFar, t2);
+    }
+    if (tFar < tNear) return false;
+
+    // ڷڲ类üпʱȡ
+    float hitT = tNear >= tMin ? tNear : tFar;
+    if (hitT < tMin || hitT > tMax) return false;
+    t = hitT;
+    return true;
+}
+
+void VoxelGrid::boxNormal(const VoxelBox& box, const float point[3], float normal[3]) {
+    float best = 1e30f;
+    int axis = 1;
+    float sign = 1.0f;
+    for (int a = 0; a < 3; ++a) {
+        float size = std::max(box.max[a] - box.min[a], 1e-6f);
+        float dMin = std::fabs(point[a] - box.min[a]) / size;
+        float dMax = std::fabs(point[a] - box.max[a]) / size;
+        if (dMin < best) { best = dMin; axis = a; sign = -1.0f; }
+        if (dMax < best) { best = dMax; axis = a; sign = 1.0f; }
+    }
+    normal[0] = normal[1] = normal[2] = 0.0f;
+    normal[axis] = sign;
+}
+
+bool VoxelGrid::raycast(const float origin[3], const float dir[3], float tMin, float tMax, VoxelHit& hit) const {
+    if (empty()) return false;
+
+    float inv[3];
+    for (int a = 0; a < 3; ++a) {
+        float d = std::fabs(dir[a]) < 1e-12f ? 1e-12f : dir[a];
+        inv[a] = 1.0f / d;
+    }
+
+    GridWalker walker;
+    if (!walker.begin(*this, origin, dir, tMin, tMax)) return false;
+
+    int bestBox = -1;
+    float bestT = tMax;
+    do {
+        uint32_t first, last;
+        if (!walker.occupied(*this, first, last)) continue;
+
+        for (uint32_t i = first; i < last; ++i) {
+            uint32_t b = cellBoxList[i];
+            float t;
+            if (intersectBox(boxList[b], origin, inv, tMin, bestT, t)) {
+                bestT = t;
+                bestBox = (int)b;
+            }
+        }
+        // ĽѾڵǰ֮ڣĸӲܸ
+        if (bestBox >= 0 && bestT <= walker.tExit) break;
+    } while (walker.next(*this));
+
+    if (bestBox < 0) return false;
+
+    hit.box = bestBox;
+    hit.t = bestT;
+    float p[3] = { origin[0] + dir[0] * bestT, origin[1] + dir[1] * bestT, origin[2] + dir[2] * bestT };
+    boxNormal(boxList[bestBox], p, hit.normal);
+    return true;
+}
+
+// ==================== GridWalker ====================
+
+bool GridWalker::begin(const VoxelGrid& grid, const float origin[3], const float dir[3], float tMin, float tMax) {
+    active = false;
+    if (grid.empty()) return false;
+
+    const float* go = grid.origin();
+    const int* n = grid.dims();
+    float cs = grid.cellSize();
+
+    // İΧ
+    float t0 = tMin, t1 = tMax;
+    for (int a = 0; a < 3; ++a) {
+        o[a] = origin[a];
+        d[a] = std::fabs(dir[a]) < 1e-12f ? 1e-12f : dir[a];
+        inv[a] = 1.0f / d[a];
+
+        float lo = (go[a] - o[a]) * inv[a];
+        float hi = (go[a] + n[a] * cs - o[a]) * inv[a];
+        if (lo > hi) std::swap(lo, hi);
+        t0 = std::max(t0, lo);
+        t1 = std::min(t1, hi);
+
+        step[a] = d[a] > 0.0f ? 1 : -1;
+        tDelta[a] = std::fabs(cs * inv[a]);
+    }
+    if (t0 > t1) return false;
+
+    tLimit = t1;
+    active = true;
+    enterAt(grid, t0);
+    return active;
+}
+
+void GridWalker::enterAt(const VoxelGrid& grid, float t) {
+    const float* go = grid.origin();
+    const int* n = grid.dims();
+    float cs = grid.cellSize();
+
+    int c[3];
+    for (int a = 0; a < 3; ++a) {
+        float p = o[a] + d[a] * t;
+        c[a] = (int)std::floor((p - go[a]) / cs);
+        c[a] = std::max(0, std::min(n[a] - 1, c[a]));
+
+        float boundary = go[a] + (c[a] + (step[a] > 0 ? 1 : 0)) * cs;
+        tMaxAxis[a] = (boundary - o[a]) * inv[a];
+    }
+    cellX = c[0]; cellY = c[1]; cellZ = c[2];
+    tEnter = t;
+    tExit = std::min(tMaxAxis[0], std::min(tMaxAxis[1], tMaxAxis[2]));
+}
+
+void GridWalker::skipEmptyBrick(const VoxelGrid& grid) {
+    const float* go = grid.origin();
+    const int* n = grid.dims();
+    float cs = grid.cellSize();
+    const int B = VoxelGrid::BRICK;
+
+    int c[3] = { cellX, cellY, cellZ };
+    float tOut = 1e30f;
+    int axis = 0;
+    for (int a = 0; a < 3; ++a) {
+        int b = c[a] / B;
+        int boundaryCell = step[a] > 0 ? (b + 1) * B : b * B;
+        float t = (go[a] + boundaryCell * cs - o[a]) * inv[a];
+        if (t < tOut) { tOut = t; axis = a; }
+    }
+
+    if (tOut > tLimit) { active = false; return; }
+
+    // ֱӽש飬ɳڵλþԭש鷶Χڣ
+    float p[3];
+    for (int a = 0; a < 3; ++a) p[a] = o[a] + d[a] * tOut;
+    for (int a = 0; a < 3; ++a) {
+        int b = c[a] / B;
+        if (a == axis) {
+            c[a] = step[a] > 0 ? (b + 1) * B : b * B - 1;
+        }
+        else {
+            int v = (int)std::floor((p[a] - go[a]) / cs);
+            c[a] = std::max(b * B, std::min(b * B + B - 1, v));
+        }
+        if (c[a] < 0 || c[a] >= n[a]) { active = false; return; }
+
+        float boundary = go[a] + (c[a] + (step[a] > 0 ? 1 : 0)) * cs;
+        tMaxAxis[a] = (boundary - o[a]) * inv[a];
+    }
+    cellX = c[0]; cellY = c[1]; cellZ = c[2];
+    tEnter = tOut;
+    tExit = std::min(tMaxAxis[0], std::min(tMaxAxis[1], tMaxAxis[2]));
+}
+
+bool GridWalker::next(const VoxelGrid& grid) {
+    if (!active) return false;
+
+    if (!grid.brickAt(cellX, cellY, cellZ)) {
+        skipEmptyBrick(grid);
+    }
+    else {
+        int axis = 0;
+        if (tMaxAxis[1] < tMaxAxis[axis]) axis = 1;
+        if (tMaxAxis[2] < tMaxAxis[axis]) axis = 2;
+
+        tEnter = tMaxAxis[axis];
+        tMaxAxis[axis] += tDelta[axis];
+        int* c[3] = { &cellX, &cellY, &cellZ };
+        *c[axis] += step[axis];
+
+        const int* n = grid.dims();
+        if (*c[axis] < 0 || *c[axis] >= n[axis]) active = false;
+        tExit = std::min(tMaxAxis[0], std::min(tMaxAxis[1], tMaxAxis[2]));
+    }
+
+    if (tEnter > tLimit) active = false;
+    return active;
+}
+
+bool GridWalker::occupied(const VoxelGrid& grid, uint32_t& first, uint32_t& last) const {
+    const VoxelGrid::Brick* brick = grid.brickAt(cellX, cellY, cellZ);
+    if (!brick) return false;
+
+    int li = VoxelGrid::localIndex(cellX, cellY, cellZ);
+    if (!((brick->occupancy >> li) & 1)) return false;
+
+    first = brick->first[li];
+    last = brick->first[li + 1];
+    return true;
+}
\ No newline at end of file
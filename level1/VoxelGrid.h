@@ -0,0 +1,105 @@
+#ifndef VOXEL_GRID_H
+#define VOXEL_GRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ռеһ뷽飨һؾ任֮ʵʰΧУ
+struct VoxelBox {
+    float min[3];
+    float max[3];
+    float r, g, b;
+};
+
+// Ϣ
+struct VoxelHit {
+    int box;            // еķ±
+    float t;            // ߲δһʱطı
+    float normal[3];    // ⷨ
+};
+
+// ϡש (Brickmap)
+// - 类Ϊ߳ cellSize ĸӣӱ߽ (k + 0.5) * cellSize ϣ
+//    1.0 ϵռһ
+// - ÿ 4x4x4 һש飬ռŽһ 64 λ
+// - ששΪ -1ռڴ棻ש
+class VoxelGrid {
+public:
+    static const int BRICK = 4;
+
+    struct Brick {
+        uint64_t occupancy;     //  i λ =  i з
+        uint32_t first[65];     //  i ӵķб cellBoxes еķΧ [first[i], first[i+1])
+    };
+
+    VoxelGrid();
+
+    void build(const std::vector<VoxelBox>& boxes, float cellSize = 1.0f);
+    void clear();
+
+    bool empty() const { return boxList.empty(); }
+    const std::vector<VoxelBox>& boxes() const { return boxList; }
+
+    // 󽻣 [tMin, tMax] Χķ
+    bool raycast(const float origin[3], const float dir[3], float tMin, float tMax, VoxelHit& hit) const;
+
+    // 뵥󽻣ڷڲʱس㣩
+    static bool intersectBox(const VoxelBox& box, const float origin[3], const float invDir[3],
+        float tMin, float tMax, float& t);
+
+    // еⷨ
+    static void boxNormal(const VoxelBox& box, const float point[3], float normal[3]);
+
+    // --- ʹõĵײӿ ---
+    float cellSize() const { return cell; }
+    const float* origin() const { return gridOrigin; }
+    const int* dims() const { return cellDims; }
+
+    // ש飬ש鷵 nullptr
+    const Brick* brickAt(int cx, int cy, int cz) const;
+    static int localIndex(int cx, int cy, int cz) {
+        return (cx & 3) + ((cy & 3) << 2) + ((cz & 3) << 4);
+    }
+    const uint32_t* cellBoxes() const { return cellBoxList.data(); }
+
+    size_t memoryBytes() const;
+
+private:
+    float cell;
+    float gridOrigin[3];
+    int cellDims[3];
+    int brickDims[3];
+
+    std::vector<VoxelBox> boxList;
+    std::vector<int> topLevel;          // ש
+    std::vector<Brick> bricks;
+    std::vector<uint32_t> cellBoxList;  // иӵķ±꣬ש顢˳
+};
+
+// ϵ 3D DDA ÿǰһӣשʱֱש
+struct GridWalker {
+    int cellX, cellY, cellZ;
+    float tEnter, tExit;        // ǰӵ߲Χ
+    bool active;
+
+    // ʼ false ʾûд
+    bool begin(const VoxelGrid& grid, const float origin[3], const float dir[3], float tMin, float tMax);
+
+    // ǰһǿשĸӣ false ʾ뿪򳬳 tMax
+    bool next(const VoxelGrid& grid);
+
+    // ǰǷз
+    bool occupied(const VoxelGrid& grid, uint32_t& first, uint32_t& last) const;
+
+private:
+    void enterAt(const VoxelGrid& grid, float t);
+    void skipEmptyBrick(const VoxelGrid& grid);
+
+    float o[3], d[3], inv[3];
+    int step[3];
+    float tMaxAxis[3], tDelta[3];
+    float tLimit;
+};
+
+#endif // VOXEL_GRID_H
\ No newline at end of file
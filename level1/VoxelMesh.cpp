@@ -0,0 +1,489 @@
+#include "VoxelMesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+// ӴֵϸԵӣ1.0 Ľǵ 0.5 ϣ0.25  0.125 ϣ
+// 0.2 ֱ 0.05 ϣͷ 0.025 Ҳܸ
+static const float QUANTUM_CANDIDATES[] = { 0.5f, 0.25f, 0.125f, 0.1f, 0.05f, 0.025f };
+static const int QUANTUM_COUNT = sizeof(QUANTUM_CANDIDATES) / sizeof(QUANTUM_CANDIDATES[0]);
+
+// ÿķߺ 4 ǣ濴ʱ룬GL_QUADS
+static const int FACE_DIRS[6][3] = {
+    { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }
+};
+static const int FACE_CORNERS[6][4][3] = {
+    { { 1, -1, 1 }, { 1, -1, -1 }, { 1, 1, -1 }, { 1, 1, 1 } },
+    { { -1, -1, -1 }, { -1, -1, 1 }, { -1, 1, 1 }, { -1, 1, -1 } },
+    { { -1, 1, 1 }, { 1, 1, 1 }, { 1, 1, -1 }, { -1, 1, -1 } },
+    { { -1, -1, -1 }, { 1, -1, -1 }, { 1, -1, 1 }, { -1, -1, 1 } },
+    { { -1, -1, 1 }, { 1, -1, 1 }, { 1, 1, 1 }, { -1, 1, 1 } },
+    { { 1, -1, -1 }, { -1, -1, -1 }, { -1, 1, -1 }, { 1, 1, -1 } }
+};
+
+// --- ɫ ---
+
+Palette::Palette() : colors(), count(0), approximatedCount(0), changed(false) {}
+
+uint8_t Palette::index(float r, float g, float b) {
+    std::lock_guard<std::mutex> guard(lock);
+    bool approximate = false;
+    return lookup(r, g, b, approximate);
+}
+
+int Palette::indexAll(const float* rgb, size_t count, uint8_t* out) {
+    std::lock_guard<std::mutex> guard(lock);
+    int approximations = 0;
+    for (size_t i = 0; i < count; ++i) {
+        bool approximate = false;
+        out[i] = lookup(rgb[i * 3], rgb[i * 3 + 1], rgb[i * 3 + 2], approximate);
+        if (approximate) approximations++;
+    }
+    return approximations;
+}
+
+uint8_t Palette::lookup(float r, float g, float b, bool& approximate) {
+    int best = 0;
+    float bestDist = 1e30f;
+    for (int i = 0; i < count; ++i) {
+        const float* c = &colors[i * 4];
+        if (c[0] == r && c[1] == g && c[2] == b) return (uint8_t)i;
+
+        float dr = c[0] - r, dg = c[1] - g, db = c[2] - b;
+        float dist = dr * dr + dg * dg + db * db;
+        if (dist < bestDist) {
+            bestDist = dist;
+            best = i;
+        }
+    }
+
+    if (count < MAX_COLORS) {
+        float* c = &colors[count * 4];
+        c[0] = r;
+        c[1] = g;
+        c[2] = b;
+        c[3] = 1.0f;
+        changed = true;
+        return (uint8_t)count++;
+    }
+
+    approximatedCount++;
+    approximate = true;
+    return (uint8_t)best;
+}
+
+int Palette::size() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return count;
+}
+
+int Palette::approximated() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return approximatedCount;
+}
+
+bool Palette::takeChanges(float* rgba) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!changed) return false;
+    std::copy(colors, colors + MAX_COLORS * 4, rgba);
+    changed = false;
+    return true;
+}
+
+// --- 񹹽 ---
+
+bool quantizeExact(float value, float quantum, int16_t& out) {
+    float k = std::round(value / quantum);
+    if (k < -32768.0f || k > 32767.0f) return false;
+    if (std::fabs(k * quantum - value) > quantum * 0.001f) return false;
+    out = (int16_t)k;
+    return true;
+}
+
+long long VoxelMeshData::vertexBytes() const {
+    long long bytes = 0;
+    for (const auto& chunk : chunks) {
+        bytes += (long long)chunk.packed.size() * sizeof(PackedVertex);
+        bytes += (long long)chunk.loose.size() * sizeof(FloatVertex);
+    }
+    return bytes;
+}
+
+// ĵĹϣ 0.0001 BakedModels.h ȥһ£
+// ÿᵥһ 64 λ귶ΧƣԶزԭ㸽ײһ
+struct PositionKey {
+    long long x, y, z;
+    bool operator==(const PositionKey& o) const { return x == o.x && y == o.y && z == o.z; }
+    bool operator!=(const PositionKey& o) const { return !(*this == o); }
+    bool operator<(const PositionKey& o) const {
+        if (x != o.x) return x < o.x;
+        if (y != o.y) return y < o.y;
+        return z < o.z;
+    }
+};
+
+struct PositionKeyHash {
+    size_t operator()(const PositionKey& k) const {
+        unsigned long long h = (unsigned long long)k.x * 73856093ULL ^
+            (unsigned long long)k.y * 19349663ULL ^ (unsigned long long)k.z * 83492791ULL;
+        return (size_t)(h ^ (h >> 17));
+    }
+};
+
+typedef std::unordered_set<PositionKey, PositionKeyHash> PositionSet;
+
+static PositionKey positionKey(float x, float y, float z) {
+    return { std::llround(x * 10000.0f), std::llround(y * 10000.0f), std::llround(z * 10000.0f) };
+}
+
+// һ񹹽õɫȼǾֲţɺ Palette::indexAll һλɵɫ
+struct ColorKey {
+    uint32_t bits[3];
+    bool operator==(const ColorKey& o) const {
+        return bits[0] == o.bits[0] && bits[1] == o.bits[1] && bits[2] == o.bits[2];
+    }
+};
+
+struct ColorKeyHash {
+    size_t operator()(const ColorKey& k) const {
+        unsigned long long h = k.bits[0] * 73856093ULL ^ k.bits[1] * 19349663ULL ^ k.bits[2] * 83492791ULL;
+        return (size_t)(h ^ (h >> 17));
+    }
+};
+
+class LocalColors {
+public:
+    int id(float r, float g, float b) {
+        const float c[3] = { r, g, b };
+        ColorKey key;
+        std::memcpy(key.bits, c, sizeof(key.bits));
+        auto it = ids.find(key);
+        if (it != ids.end()) return it->second;
+        int next = (int)ids.size();
+        ids.emplace(key, next);
+        rgb.insert(rgb.end(), c, c + 3);
+        return next;
+    }
+
+    size_t size() const { return ids.size(); }
+    const float* data() const { return rgb.data(); }
+
+private:
+    std::unordered_map<ColorKey, int, ColorKeyHash> ids;
+    std::vector<float> rgb;
+};
+
+// --- 決 ---
+
+// ڵ 0..3 
+static const float AO_FACTORS[4] = { 1.0f, 0.8f, 0.65f, 0.5f };
+
+// ǵ㱻ڵĳ̶ȣһڵغһԽ
+// 涼ʱѾסܶԽûж 3
+static int cornerOcclusion(const PositionSet& occupied, const float* v, int face,
+    const int* corner, float voxelSize) {
+    const int* d = FACE_DIRS[face];
+    int axis = face / 2;
+    int t1 = (axis + 1) % 3, t2 = (axis + 2) % 3;
+    auto filled = [&](int s1, int s2) {
+        float p[3] = { v[0] + d[0] * voxelSize, v[1] + d[1] * voxelSize, v[2] + d[2] * voxelSize };
+        p[t1] += s1 * voxelSize;
+        p[t2] += s2 * voxelSize;
+        return occupied.count(positionKey(p[0], p[1], p[2])) > 0;
+    };
+    bool side1 = filled(corner[t1], 0);
+    bool side2 = filled(0, corner[t2]);
+    if (side1 && side2) return 3;
+    return (int)side1 + (int)side2 + (int)filled(corner[t1], corner[t2]);
+}
+
+// һ 4 ǵĺ決ȣ * AOػʱʼǣ0  1
+// GL_QUADS  0-2 Խ߲ΣһԽǷڶԽϣǵӰضԽһ
+static int faceBrightness(const LightBake& bake, const PositionSet& occupied, const float* v,
+    int face, float voxelSize, float brightness[4]) {
+    const int* d = FACE_DIRS[face];
+    float nDotL = d[0] * bake.direction[0] + d[1] * bake.direction[1] + d[2] * bake.direction[2];
+    float light = bake.ambient + bake.diffuse * std::max(nDotL, 0.0f);
+
+    for (int c = 0; c < 4; ++c) {
+        brightness[c] = light * AO_FACTORS[cornerOcclusion(occupied, v, face, FACE_CORNERS[face][c], voxelSize)];
+    }
+    return brightness[0] + brightness[2] < brightness[1] + brightness[3] ? 1 : 0;
+}
+
+// һ 4 ǵĺ決ɫֵͬ faceBrightness
+static int bakeFace(const LightBake& bake, const PositionSet& occupied, const float* v,
+    int face, float voxelSize, float rgb[4][3]) {
+    float brightness[4];
+    int first = faceBrightness(bake, occupied, v, face, voxelSize, brightness);
+    for (int c = 0; c < 4; ++c) {
+        for (int a = 0; a < 3; ++a) rgb[c][a] = std::min(v[3 + a] * brightness[c], 1.0f);
+    }
+    return first;
+}
+
+static bool packVoxel(const float* v, const float origin[3], float half, float quantum, int16_t lo[3], int16_t hi[3]) {
+    for (int a = 0; a < 3; ++a) {
+        if (!quantizeExact(v[a] - half - origin[a], quantum, lo[a])) return false;
+        if (!quantizeExact(v[a] + half - origin[a], quantum, hi[a])) return false;
+    }
+    return true;
+}
+
+ChunkKey meshChunkKey(float x, float y, float z) {
+    return { (int)std::floor(x / MESH_CHUNK_SIZE), (int)std::floor(y / MESH_CHUNK_SIZE), (int)std::floor(z / MESH_CHUNK_SIZE) };
+}
+
+// only Ϊʱֻг飨򣩣ֻ޳
+static VoxelMeshData buildMeshChunks(const float* xyzrgb, size_t count, size_t stride,
+    float voxelSize, Palette& palette, uint8_t tag, const LightBake* bake, const std::vector<ChunkKey>* only) {
+    VoxelMeshData mesh;
+    mesh.voxelSize = voxelSize;
+    mesh.baked = bake != nullptr;
+    if (count == 0) return mesh;
+
+    const float half = voxelSize * 0.5f;
+
+    // 1. ķŽϣжĳǷصס
+    PositionSet occupied;
+    occupied.reserve(count * 2);
+    for (size_t i = 0; i < count; ++i) {
+        const float* v = xyzrgb + i * stride;
+        occupied.insert(positionKey(v[0], v[1], v[2]));
+    }
+
+    // 2. 飨ڱԭ˳
+    struct Entry {
+        int key[3];
+        size_t index;
+    };
+    std::vector<Entry> entries;
+    entries.reserve(only ? 0 : count);
+    for (size_t i = 0; i < count; ++i) {
+        const float* v = xyzrgb + i * stride;
+        ChunkKey k = meshChunkKey(v[0], v[1], v[2]);
+        if (only && !std::binary_search(only->begin(), only->end(), k)) continue;
+        entries.push_back({ { k.x, k.y, k.z }, i });
+    }
+    const size_t entryCount = entries.size();
+    // ÿľֲɫţ chunk.packed / chunk.loose һһӦ
+    LocalColors localColors;
+    std::vector<std::vector<int>> packedColorIds, looseColorIds;
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        if (a.key[0] != b.key[0]) return a.key[0] < b.key[0];
+        if (a.key[1] != b.key[1]) return a.key[1] < b.key[1];
+        return a.key[2] < b.key[2];
+    });
+
+    size_t begin = 0;
+    while (begin < entryCount) {
+        size_t end = begin + 1;
+        while (end < entryCount && std::equal(entries[end].key, entries[end].key + 3, entries[begin].key)) ++end;
+
+        MeshChunk chunk;
+        for (int a = 0; a < 3; ++a) {
+            chunk.key[a] = entries[begin].key[a];
+            chunk.origin[a] = chunk.key[a] * MESH_CHUNK_SIZE;
+            chunk.boundsMin[a] = 1e30f;
+            chunk.boundsMax[a] = -1e30f;
+        }
+        chunk.voxelCount = (int)(end - begin);
+        std::vector<int> packedIds, looseIds;
+
+        // 3. ѡصӣͬʱȡϴֵģ
+        int16_t lo[3], hi[3];
+        int bestPacked = -1;
+        chunk.quantum = QUANTUM_CANDIDATES[0];
+        for (int q = 0; q < QUANTUM_COUNT; ++q) {
+            int packedCount = 0;
+            for (size_t e = begin; e < end; ++e) {
+                const float* v = xyzrgb + entries[e].index * stride;
+                if (packVoxel(v, chunk.origin, half, QUANTUM_CANDIDATES[q], lo, hi)) packedCount++;
+            }
+            if (packedCount > bestPacked) {
+                bestPacked = packedCount;
+                chunk.quantum = QUANTUM_CANDIDATES[q];
+            }
+            if (packedCount == chunk.voxelCount) break;
+        }
+
+        // 4. ɿɼ
+        for (size_t e = begin; e < end; ++e) {
+            const float* v = xyzrgb + entries[e].index * stride;
+            int color = bake ? 0 : localColors.id(v[3], v[4], v[5]);
+            bool packable = packVoxel(v, chunk.origin, half, chunk.quantum, lo, hi);
+            if (packable) mesh.packedVoxels++;
+            else mesh.looseVoxels++;
+
+            for (int a = 0; a < 3; ++a) {
+                chunk.boundsMin[a] = std::min(chunk.boundsMin[a], v[a] - half);
+                chunk.boundsMax[a] = std::max(chunk.boundsMax[a], v[a] + half);
+            }
+
+            for (int f = 0; f < 6; ++f) {
+                const int* d = FACE_DIRS[f];
+                if (occupied.count(positionKey(v[0] + d[0] * voxelSize, v[1] + d[1] * voxelSize, v[2] + d[2] * voxelSize))) {
+                    mesh.culledFaces++;
+                    continue;
+                }
+
+                int colors[4] = { color, color, color, color };
+                int first = 0;
+                if (bake) {
+                    float rgb[4][3];
+                    first = bakeFace(*bake, occupied, v, f, voxelSize, rgb);
+                    for (int c = 0; c < 4; ++c) colors[c] = localColors.id(rgb[c][0], rgb[c][1], rgb[c][2]);
+                }
+
+                for (int k = 0; k < 4; ++k) {
+                    int c = (first + k) % 4;
+                    const int* s = FACE_CORNERS[f][c];
+                    if (packable) {
+                        int16_t q[3];
+                        for (int a = 0; a < 3; ++a) {
+                            q[a] = s[a] > 0 ? hi[a] : lo[a];
+                            float exact = v[a] + s[a] * half - chunk.origin[a];
+                            mesh.maxError = std::max(mesh.maxError, std::fabs(q[a] * chunk.quantum - exact));
+                        }
+                        chunk.packed.push_back({ q[0], q[1], q[2], (uint8_t)(f | tag), 0 });
+                        packedIds.push_back(colors[c]);
+                    } else {
+                        FloatVertex fv;
+                        fv.x = v[0] + s[0] * half - chunk.origin[0];
+                        fv.y = v[1] + s[1] * half - chunk.origin[1];
+                        fv.z = v[2] + s[2] * half - chunk.origin[2];
+                        fv.normal = (uint8_t)(f | tag);
+                        fv.color = 0;
+                        fv.pad[0] = fv.pad[1] = 0;
+                        chunk.loose.push_back(fv);
+                        looseIds.push_back(colors[c]);
+                    }
+                }
+            }
+        }
+
+        mesh.chunks.push_back(std::move(chunk));
+        packedColorIds.push_back(std::move(packedIds));
+        looseColorIds.push_back(std::move(looseIds));
+        begin = end;
+    }
+
+    // 5. ֲɫһλɵɫ
+    std::vector<uint8_t> paletteIndex(localColors.size());
+    if (!paletteIndex.empty()) {
+        mesh.approximatedColors = palette.indexAll(localColors.data(), localColors.size(), paletteIndex.data());
+    }
+    for (size_t i = 0; i < mesh.chunks.size(); ++i) {
+        MeshChunk& chunk = mesh.chunks[i];
+        for (size_t k = 0; k < chunk.packed.size(); ++k) chunk.packed[k].color = paletteIndex[packedColorIds[i][k]];
+        for (size_t k = 0; k < chunk.loose.size(); ++k) chunk.loose[k].color = paletteIndex[looseColorIds[i][k]];
+    }
+
+    return mesh;
+}
+
+VoxelMeshData buildVoxelMesh(const float* xyzrgb, size_t count, size_t stride,
+    float voxelSize, Palette& palette, uint8_t tag, const LightBake* bake) {
+    return buildMeshChunks(xyzrgb, count, stride, voxelSize, palette, tag, bake, nullptr);
+}
+
+VoxelMeshData buildVoxelMeshChunks(const float* xyzrgb, size_t count, size_t stride,
+    float voxelSize, Palette& palette, const std::vector<ChunkKey>& chunks, uint8_t tag, const LightBake* bake) {
+    std::vector<ChunkKey> sorted(chunks);
+    std::sort(sorted.begin(), sorted.end());
+    return buildMeshChunks(xyzrgb, count, stride, voxelSize, palette, tag, bake, &sorted);
+}
+
+std::vector<ChunkKey> diffMeshChunks(const float* oldXyzrgb, size_t oldCount,
+    const float* newXyzrgb, size_t newCount, size_t stride, float voxelSize) {
+    // ÿر (λü, ɫ, ±)һι鲢ҳֻһֵ߳
+    struct Item {
+        PositionKey position;
+        float r, g, b;
+        const float* v;
+        bool operator<(const Item& o) const {
+            if (position != o.position) return position < o.position;
+            if (r != o.r) return r < o.r;
+            if (g != o.g) return g < o.g;
+            return b < o.b;
+        }
+    };
+    auto collect = [stride](const float* xyzrgb, size_t count) {
+        std::vector<Item> items(count);
+        for (size_t i = 0; i < count; ++i) {
+            const float* v = xyzrgb + i * stride;
+            items[i] = { positionKey(v[0], v[1], v[2]), v[3], v[4], v[5], v };
+        }
+        std::sort(items.begin(), items.end());
+        return items;
+    };
+    std::vector<Item> before = collect(oldXyzrgb, oldCount);
+    std::vector<Item> after = collect(newXyzrgb, newCount);
+
+    // 仯ڵҪؽΧ 26 λڱ飬Ǹ޳決 AO Ҳ
+    std::vector<ChunkKey> dirty;
+    auto mark = [&](const float* v) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dz = -1; dz <= 1; ++dz) {
+                    dirty.push_back(meshChunkKey(v[0] + dx * voxelSize, v[1] + dy * voxelSize, v[2] + dz * voxelSize));
+                }
+            }
+        }
+    };
+
+    size_t i = 0, j = 0;
+    while (i < before.size() || j < after.size()) {
+        if (j == after.size() || (i < before.size() && before[i] < after[j])) {
+            mark(before[i++].v);
+        } else if (i == before.size() || after[j] < before[i]) {
+            mark(after[j++].v);
+        } else {
+            ++i;
+            ++j;
+        }
+    }
+
+    std::sort(dirty.begin(), dirty.end());
+    dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+    return dirty;
+}
+
+std::vector<GlyphVertex> buildGlyphMesh(const float* xyz, size_t count, size_t stride, float voxelSize,
+    const LightBake& bake) {
+    std::vector<GlyphVertex> vertices;
+    const float half = voxelSize * 0.5f;
+
+    PositionSet occupied;
+    occupied.reserve(count * 2);
+    for (size_t i = 0; i < count; ++i) {
+        const float* v = xyz + i * stride;
+        occupied.insert(positionKey(v[0], v[1], v[2]));
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const float* v = xyz + i * stride;
+        for (int f = 0; f < 6; ++f) {
+            const int* d = FACE_DIRS[f];
+            if (occupied.count(positionKey(v[0] + d[0] * voxelSize, v[1] + d[1] * voxelSize, v[2] + d[2] * voxelSize))) {
+                continue;
+            }
+            float brightness[4];
+            int first = faceBrightness(bake, occupied, v, f, voxelSize, brightness);
+            for (int k = 0; k < 4; ++k) {
+                int c = (first + k) % 4;
+                const int* s = FACE_CORNERS[f][c];
+                GlyphVertex gv = {
+                    v[0] + s[0] * half, v[1] + s[1] * half, v[2] + s[2] * half,
+                    v[0], v[1], v[2],
+                    brightness[c]
+                };
+                vertices.push_back(gv);
+            }
+        }
+    }
+    return vertices;
+}
\ No newline at end of file
@@ -0,0 +1,208 @@
+#ifndef VOXEL_MESH_H
+#define VOXEL_MESH_H
+
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include "Voxel.h"
+
+// 񹹽ֻ CPU ݣ漰 GLڹ߳ã
+// - ģͰ 16x16x16 з֣ͬߴ֮汻޳
+// -  8 ֽڣλԭ int16λΪӣ
+//   ټ 3 λ 8 λɫɫ
+// - κ֧ϵأֱ 0.0009 أ㶥㣬
+//   ֤
+
+const float MESH_CHUNK_SIZE = 16.0f;
+
+// PackedVertex::normal ĵ 3 λ
+enum FaceNormal {
+    FACE_POS_X, FACE_NEG_X,
+    FACE_POS_Y, FACE_NEG_Y,
+    FACE_POS_Z, FACE_NEG_Z
+};
+
+const int NORMAL_BITS = 0x07;
+
+// ֽڵĸλǣɫʵʱλƶǵĶ
+const uint8_t VERTEX_TAG_BROW = 1 << 3;     // üëy  faceBrowOffset
+const uint8_t VERTEX_TAG_GLINT = 1 << 4;    // ⣺x  faceGlintPositionھƬʱ
+
+//  (8 ֽ)
+struct PackedVertex {
+    int16_t x, y, z;    // ԭ㣬 MeshChunk::quantum ԭ
+    uint8_t normal;     //  3 λFaceNormalλ
+    uint8_t color;      // ɫ
+};
+
+// 㶥 (16 ֽ)޷
+struct FloatVertex {
+    float x, y, z;      // ԭ
+    uint8_t normal;
+    uint8_t color;
+    uint8_t pad[2];
+};
+
+// ʵ (8 ֽ)ʵʱÿֻҪλúɫ
+struct PackedInstance {
+    int16_t x, y, z;    // ģӻԭ
+    uint8_t color;
+    uint8_t flags;      // ǣ INSTANCE_WATER
+};
+
+const uint8_t INSTANCE_WATER = 1;   // ɫﰴ waterWaveHeight ϲ˸߶
+
+// ȫֵɫ壺д㹲ã 256 ɫ
+// ʱӳ䵽ӽɫ approximated()
+class Palette {
+public:
+    static const int MAX_COLORS = 256;
+
+    Palette();
+
+    // ɫҪʱ̰߳ȫ
+    uint8_t index(float r, float g, float b);
+    // һμ count ɫrgb ÿ 3  float һ֣ӳ䵽ɫĸ
+    // 񹹽ڱռظɫһΣ֮߳䲻
+    int indexAll(const float* rgb, size_t count, uint8_t* out);
+
+    int size() const;
+    int approximated() const;
+
+    // ɫʱ RGBA ݣMAX_COLORS * 4  float trueͬʱĶ
+    bool takeChanges(float* rgba);
+
+private:
+    uint8_t lookup(float r, float g, float b, bool& approximate);   // ÷ lock
+
+    mutable std::mutex lock;
+    float colors[MAX_COLORS * 4];
+    int count;
+    int approximatedCount;
+    bool changed;
+};
+
+struct MeshChunk {
+    int key[3];                 // 
+    float origin[3];            // ԭ = key * MESH_CHUNK_SIZE
+    float quantum;              // λõλ
+    float boundsMin[3];         // صİΧУ׶޳
+    float boundsMax[3];
+    int voxelCount;
+    std::vector<PackedVertex> packed;   // GL_QUADSÿ 4 
+    std::vector<FloatVertex> loose;
+};
+
+struct VoxelMeshData {
+    float voxelSize = 1.0f;
+    bool baked = false;             // ɫѾ決˹գʱټ
+    std::vector<MeshChunk> chunks;
+    int packedVoxels = 0;
+    int looseVoxels = 0;
+    long long culledFaces = 0;      // صסʡ
+    int approximatedColors = 0;     // ɫӳ䵽ӽɫɫ
+    float maxError = 0.0f;          // λԭʼλõ
+
+    long long vertexBytes() const;
+    int voxelCount() const { return packedVoxels + looseVoxels; }
+};
+
+// 決գ + ػڱΣÿ㿴ڵ 3 أֱдɫ
+// շģֻڲתľ̬ģͣ߹ӽйأ決
+struct LightBake {
+    float direction[3];     // ָԴĵλ
+    float ambient;          // ȫֻ + Դ
+    float diffuse;
+};
+
+// xyzrgb ָһص xstride ؼ float tag дÿķֽ
+// bake ΪʱɫǺ決ɫÿ 4 ֣Ҫɫ壩
+VoxelMeshData buildVoxelMesh(const float* xyzrgb, size_t count, size_t stride,
+    float voxelSize, Palette& palette, uint8_t tag = 0, const LightBake* bake = nullptr);
+
+template <class V>
+VoxelMeshData buildVoxelMesh(const V* voxels, size_t count, float voxelSize, Palette& palette, uint8_t tag = 0,
+    const LightBake* bake = nullptr) {
+    return buildVoxelMesh(count ? &voxels[0].x : nullptr, count, sizeof(V) / sizeof(float), voxelSize, palette, tag, bake);
+}
+
+// ꣨ xyz Һȥصļ
+struct ChunkKey {
+    int x, y, z;
+    bool operator<(const ChunkKey& o) const {
+        if (x != o.x) return x < o.x;
+        if (y != o.y) return y < o.y;
+        return z < o.z;
+    }
+    bool operator==(const ChunkKey& o) const { return x == o.x && y == o.y && z == o.z; }
+};
+
+// ڵ
+ChunkKey meshChunkKey(float x, float y, float z);
+
+// ֻ chunks г飬޳ȻȫأԽӦͬ
+// гѾûأû÷Ӧɾɵ飩
+VoxelMeshData buildVoxelMeshChunks(const float* xyzrgb, size_t count, size_t stride,
+    float voxelSize, Palette& palette, const std::vector<ChunkKey>& chunks, uint8_t tag = 0,
+    const LightBake* bake = nullptr);
+
+template <class V>
+VoxelMeshData buildVoxelMeshChunks(const V* voxels, size_t count, float voxelSize, Palette& palette,
+    const std::vector<ChunkKey>& chunks, uint8_t tag = 0, const LightBake* bake = nullptr) {
+    return buildVoxelMeshChunks(count ? &voxels[0].x : nullptr, count, sizeof(V) / sizeof(float), voxelSize, palette,
+        chunks, tag, bake);
+}
+
+// Ƚͬһģ͵¾أλ + ɫ˳޹أҪؽ飨򡢲ظ
+// ɾɫ飬ԼЩΧ 26 λڵ飨޳ͺ決 AO ű䣩
+std::vector<ChunkKey> diffMeshChunks(const float* oldXyzrgb, size_t oldCount,
+    const float* newXyzrgb, size_t newCount, size_t stride, float voxelSize);
+
+template <class V>
+std::vector<ChunkKey> diffMeshChunks(const std::vector<V>& before, const std::vector<V>& after, float voxelSize) {
+    return diffMeshChunks(before.empty() ? nullptr : &before[0].x, before.size(),
+        after.empty() ? nullptr : &after[0].x, after.size(), sizeof(V) / sizeof(float), voxelSize);
+}
+
+// ζ (28 ֽ)ɫڶɫֵĽͶ
+// light Ǻ決ȣ * AOδضϣɫ = min(ɫ * light, 1)
+struct GlyphVertex {
+    float x, y, z;          // ǵ
+    float cx, cy, cz;       // ص
+    float light;
+};
+
+// ɼ GL_QUADS 㣬 buildVoxelMesh һ޳صס桢 bake 決
+// xyz ָһص xstride ؼ float 
+std::vector<GlyphVertex> buildGlyphMesh(const float* xyz, size_t count, size_t stride, float voxelSize,
+    const LightBake& bake);
+
+template <class V>
+std::vector<GlyphVertex> buildGlyphMesh(const V* voxels, size_t count, float voxelSize, const LightBake& bake) {
+    return buildGlyphMesh(count ? &voxels[0].x : nullptr, count, sizeof(V) / sizeof(float), voxelSize, bake);
+}
+
+// value / quantum Сӵǧ֮һ int16 Χʱ true
+bool quantizeExact(float value, float quantum, int16_t& out);
+
+// Ĵʵݣκزܰ quantum ʾʱ false
+template <class V>
+bool buildInstances(const V* voxels, size_t count, float quantum, uint8_t flags,
+    Palette& palette, std::vector<PackedInstance>& out) {
+    out.clear();
+    out.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const V& v = voxels[i];
+        PackedInstance inst;
+        if (!quantizeExact(v.x, quantum, inst.x) || !quantizeExact(v.y, quantum, inst.y) ||
+            !quantizeExact(v.z, quantum, inst.z)) {
+            return false;
+        }
+        inst.color = palette.index(v.r, v.g, v.b);
+        inst.flags = flags;
+        out.push_back(inst);
+    }
+    return true;
+}
+
+#endif // VOXEL_MESH_H
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "VoxelQuery.h"
+
+#include <algorithm>
+#include <cmath>
+#include "JobSystem.h"
+
+// ƶʱͣڷ֮ǰľ룬⸡һβѯгѾص
+static const float COLLISION_SKIN = 1e-3f;
+
+// ÿ
+static const int RAY_BATCH_GRAIN = 256;
+
+void VoxelQuery::clear() {
+    pending.clear();
+    grid.clear();
+    setOffset(0.0f, 0.0f, 0.0f);
+}
+
+void VoxelQuery::setOffset(float x, float y, float z) {
+    offset[0] = x;
+    offset[1] = y;
+    offset[2] = z;
+}
+
+void VoxelQuery::addVoxel(float x, float y, float z, float size, float r, float g, float b) {
+    float half = size * 0.5f;
+    float cx = offset[0] + x, cy = offset[1] + y, cz = offset[2] + z;
+    VoxelBox box = {
+        { cx - half, cy - half, cz - half },
+        { cx + half, cy + half, cz + half },
+        r, g, b
+    };
+    pending.push_back(box);
+}
+
+void VoxelQuery::build(float cellSize) {
+    grid.build(pending, cellSize);
+    pending.clear();
+    pending.shrink_to_fit();
+}
+
+bool VoxelQuery::raycast(const float origin[3], const float dir[3], float maxDist, VoxelHit& hit) const {
+    return grid.raycast(origin, dir, 0.0f, maxDist, hit);
+}
+
+bool VoxelQuery::occluded(const float origin[3], const float dir[3], float maxDist) const {
+    if (grid.empty()) return false;
+
+    float inv[3];
+    for (int a = 0; a < 3; ++a) {
+        float d = std::fabs(dir[a]) < 1e-12f ? 1e-12f : dir[a];
+        inv[a] = 1.0f / d;
+    }
+
+    GridWalker walker;
+    if (!walker.begin(grid, origin, dir, 0.0f, maxDist)) return false;
+
+    const std::vector<VoxelBox>& boxes = grid.boxes();
+    const uint32_t* cellBoxes = grid.cellBoxes();
+    do {
+        uint32_t first, last;
+        if (!walker.occupied(grid, first, last)) continue;
+
+        for (uint32_t i = first; i < last; ++i) {
+            float t;
+            if (VoxelGrid::intersectBox(boxes[cellBoxes[i]], origin, inv, 0.0f, maxDist, t)) return true;
+        }
+    } while (walker.next(grid));
+    return false;
+}
+
+void VoxelQuery::raycastBatch(const RayQuery* rays, int count, VoxelHit* results, JobSystem* jobs) const {
+    auto kernel = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            const RayQuery& ray = rays[i];
+            if (!grid.raycast(ray.origin, ray.dir, 0.0f, ray.maxDist, results[i])) {
+                results[i].box = -1;
+            }
+        }
+    };
+
+    if (jobs) jobs->parallelFor(0, count, RAY_BATCH_GRAIN, kernel);
+    else kernel(0, count);
+}
+
+int VoxelQuery::overlap(const float min[3], const float max[3], std::vector<int>& out) const {
+    out.clear();
+    if (grid.empty()) return 0;
+
+    const float* go = grid.origin();
+    const int* n = grid.dims();
+    float cs = grid.cellSize();
+
+    int c0[3], c1[3];
+    for (int a = 0; a < 3; ++a) {
+        c0[a] = (int)std::floor((min[a] - go[a]) / cs);
+        c1[a] = (int)std::floor((max[a] - go[a]) / cs);
+        if (c1[a] < 0 || c0[a] >= n[a]) return 0;
+        c0[a] = std::max(c0[a], 0);
+        c1[a] = std::min(c1[a], n[a] - 1);
+    }
+
+    const int B = VoxelGrid::BRICK;
+    const std::vector<VoxelBox>& boxes = grid.boxes();
+    const uint32_t* cellBoxes = grid.cellBoxes();
+
+    for (int bz = c0[2] / B; bz <= c1[2] / B; ++bz) {
+        for (int by = c0[1] / B; by <= c1[1] / B; ++by) {
+            for (int bx = c0[0] / B; bx <= c1[0] / B; ++bx) {
+                const VoxelGrid::Brick* brick = grid.brickAt(bx * B, by * B, bz * B);
+                if (!brick) continue;
+
+                // ѯΧשĸӣռȡ
+                uint64_t mask = 0;
+                for (int z = std::max(c0[2], bz * B); z <= std::min(c1[2], bz * B + B - 1); ++z) {
+                    for (int y = std::max(c0[1], by * B); y <= std::min(c1[1], by * B + B - 1); ++y) {
+                        for (int x = std::max(c0[0], bx * B); x <= std::min(c1[0], bx * B + B - 1); ++x) {
+                            mask |= (uint64_t)1 << VoxelGrid::localIndex(x, y, z);
+                        }
+                    }
+                }
+                mask &= brick->occupancy;
+
+                for (int c = 0; mask; ++c, mask >>= 1) {
+                    if (!(mask & 1)) continue;
+                    for (uint32_t i = brick->first[c]; i < brick->first[c + 1]; ++i) {
+                        const VoxelBox& b = boxes[cellBoxes[i]];
+                        if (b.min[0] <= max[0] && b.max[0] >= min[0] &&
+                            b.min[1] <= max[1] && b.max[1] >= min[1] &&
+                            b.min[2] <= max[2] && b.max[2] >= min[2]) {
+                            out.push_back((int)cellBoxes[i]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // ӵķᱻҵ
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return (int)out.size();
+}
+
+bool VoxelQuery::sweep(const float center[3], const float halfExtent[3], const float dir[3], float maxDist,
+    VoxelHit& hit) const {
+    // ɸƶɨİΧ
+    float lo[3], hi[3];
+    for (int a = 0; a < 3; ++a) {
+        float end = center[a] + dir[a] * maxDist;
+        lo[a] = std::min(center[a], end) - halfExtent[a];
+        hi[a] = std::max(center[a], end) + halfExtent[a];
+    }
+    std::vector<int> candidates;
+    if (overlap(lo, hi, candidates) == 0) return false;
+
+    // ϸ⣺鰴 halfExtent ĵ
+    int bestBox = -1, bestAxis = 0;
+    float bestT = maxDist;
+    for (int index : candidates) {
+        const VoxelBox& b = grid.boxes()[index];
+        float tNear = -1e30f, tFar = 1e30f;
+        int nearAxis = 0;
+        bool miss = false;
+        for (int a = 0; a < 3 && !miss; ++a) {
+            float bmin = b.min[a] - halfExtent[a];
+            float bmax = b.max[a] + halfExtent[a];
+            if (std::fabs(dir[a]) < 1e-12f) {
+                // ƶֻϸڷΧڲſŲ滬
+                miss = center[a] <= bmin || center[a] >= bmax;
+                continue;
+            }
+            float t1 = (bmin - center[a]) / dir[a];
+            float t2 = (bmax - center[a]) / dir[a];
+            if (t1 > t2) std::swap(t1, t2);
+            if (t1 > tNear) { tNear = t1; nearAxis = a; }
+            tFar = std::min(tFar, t2);
+        }
+        if (miss || tFar <= tNear || tFar <= 0.0f) continue;
+        if (tNear < 0.0f) continue;     // Ѿص
+        if (tNear <= bestT) {
+            bestT = tNear;
+            bestBox = index;
+            bestAxis = nearAxis;
+        }
+    }
+    if (bestBox < 0) return false;
+
+    hit.box = bestBox;
+    hit.t = bestT;
+    hit.normal[0] = hit.normal[1] = hit.normal[2] = 0.0f;
+    hit.normal[bestAxis] = dir[bestAxis] > 0.0f ? -1.0f : 1.0f;
+    return true;
+}
+
+bool VoxelQuery::moveWithCollision(float center[3], const float delta[3], const float halfExtent[3]) const {
+    static const int AXIS_ORDER[3] = { 0, 2, 1 };
+    bool collided = false;
+    for (int k = 0; k < 3; ++k) {
+        int a = AXIS_ORDER[k];
+        if (delta[a] == 0.0f) continue;
+
+        float dir[3] = { 0.0f, 0.0f, 0.0f };
+        dir[a] = delta[a] > 0.0f ? 1.0f : -1.0f;
+        float dist = std::fabs(delta[a]);
+
+        VoxelHit hit;
+        if (sweep(center, halfExtent, dir, dist, hit)) {
+            dist = std::max(0.0f, hit.t - COLLISION_SKIN);
+            collided = true;
+        }
+        center[a] += dir[a] * dist;
+    }
+    return collided;
+}
\ No newline at end of file
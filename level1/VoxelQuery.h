@@ -0,0 +1,60 @@
+#ifndef VOXEL_QUERY_H
+#define VOXEL_QUERY_H
+
+#include <vector>
+#include "VoxelGrid.h"
+
+class JobSystem;
+
+// ߲ѯһߣdir Ҫһо VoxelHit::t
+struct RayQuery {
+    float origin[3];
+    float dir[3];
+    float maxDist;
+};
+
+// ̬ײ / ʰȡѯģʽײѡأ
+// - Ž VoxelGrid 3D DDA ߸ӣש鰴 64 λռ
+// - ӲѯռɸոӣֻԷǿոķ AABB 
+// - вѯֻģڶ߳ͬʱ
+class VoxelQuery {
+public:
+    // --- ռaddVoxel Ĳ drawCube ͬoffset ֮ӵЧ ---
+    void clear();
+    void setOffset(float x, float y, float z);
+    void addVoxel(float x, float y, float z, float size, float r, float g, float b);
+    void build(float cellSize = 1.0f);
+
+    bool empty() const { return grid.empty(); }
+    int boxCount() const { return (int)grid.boxes().size(); }
+    const VoxelBox& box(int index) const { return grid.boxes()[index]; }
+    const VoxelGrid& voxelGrid() const { return grid; }
+
+    // Уûз false
+    bool raycast(const float origin[3], const float dir[3], float maxDist, VoxelHit& hit) const;
+
+    // ֻûڵһͷ
+    bool occluded(const float origin[3], const float dir[3], float maxDist) const;
+
+    // Уresults[i].box = -1 ʾûУʱ
+    void raycastBatch(const RayQuery* rays, int count, VoxelHit* results, JobSystem* jobs) const;
+
+    //  [min, max] ཻķ±꣨ظظ
+    int overlap(const float min[3], const float max[3], std::vector<int>& out) const;
+
+    // ߳Ϊ halfExtent ĺӴ center  dirһƶ maxDistصһνӴ
+    // ѾͷصĲ㣬ڷʱȻ߳
+    bool sweep(const float center[3], const float halfExtent[3], const float dir[3], float maxDist,
+        VoxelHit& hit) const;
+
+    //  xzy ˳ƶͣڱǰǽ
+    // Ƿײ
+    bool moveWithCollision(float center[3], const float delta[3], const float halfExtent[3]) const;
+
+private:
+    std::vector<VoxelBox> pending;
+    float offset[3] = { 0.0f, 0.0f, 0.0f };
+    VoxelGrid grid;
+};
+
+#endif // VOXEL_QUERY_H
\ No newline at end of file
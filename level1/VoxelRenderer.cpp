@@ -0,0 +1,750 @@
+#include "VoxelRenderer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "Crowd.h"
+#include "JobSystem.h"
+#include "Stats.h"
+#include "Utils.h"
+
+// --- ɫ ---
+
+//  init() еĹ̶һ£GL_COLOR_MATERIAL ( + ȡɫ)
+// ⣬ GL_NORMALIZEǾֲ۲ߵľ߹⣻Ϊ EXP2۾ռȼ
+static const char* SHADER_COMMON =
+    "#version 120\n"
+    "uniform sampler2D uPalette;\n"
+    "varying vec4 vColor;\n"
+    "varying float vFogDepth;\n"
+    "vec3 paletteColor(float index) {\n"
+    "    return texture2DLod(uPalette, vec2((index + 0.5) / 256.0, 0.5), 0.0).rgb;\n"
+    "}\n"
+    "vec3 faceNormal(float code) {\n"
+    "    float n = mod(code, 8.0);\n"
+    "    float axis = floor(n * 0.5);\n"
+    "    float s = 1.0 - 2.0 * mod(n, 2.0);\n"
+    "    return vec3(axis == 0.0 ? s : 0.0, axis == 1.0 ? s : 0.0, axis == 2.0 ? s : 0.0);\n"
+    "}\n"
+    "void lightVertex(vec4 eyePos, vec3 normal, vec3 color) {\n"
+    "    vec3 n = gl_NormalMatrix * normal;\n"
+    "    vec3 l = normalize(gl_LightSource[0].position.xyz);\n"
+    "    float nDotL = max(dot(n, l), 0.0);\n"
+    "    vec3 c = (gl_LightModel.ambient.rgb + gl_LightSource[0].ambient.rgb) * color\n"
+    "        + gl_LightSource[0].diffuse.rgb * color * nDotL;\n"
+    "    if (nDotL > 0.0) {\n"
+    "        float nDotH = max(dot(n, gl_LightSource[0].halfVector.xyz), 0.0);\n"
+    "        c += gl_FrontMaterial.specular.rgb * gl_LightSource[0].specular.rgb\n"
+    "            * pow(nDotH, gl_FrontMaterial.shininess);\n"
+    "    }\n"
+    "    vColor = vec4(clamp(c, 0.0, 1.0), 1.0);\n"
+    "    vFogDepth = abs(eyePos.z);\n"
+    "}\n";
+
+// λ = ԭ +  * 
+// uBaked = 1 ʱɫɫѾգLightBakeֻ
+static const char* MESH_VERTEX_SHADER =
+    "attribute vec3 aPosition;\n"
+    "attribute vec2 aCode;\n"       // x: , y: ɫ
+    "uniform vec3 uOrigin;\n"
+    "uniform float uQuantum;\n"
+    "uniform float uBaked;\n"
+    "void main() {\n"
+    "    vec4 eyePos = gl_ModelViewMatrix * vec4(uOrigin + aPosition * uQuantum, 1.0);\n"
+    "    if (uBaked > 0.5) {\n"
+    "        vColor = vec4(paletteColor(aCode.y), 1.0);\n"
+    "        vFogDepth = abs(eyePos.z);\n"
+    "    } else {\n"
+    "        lightVertex(eyePos, faceNormal(aCode.x), paletteColor(aCode.y));\n"
+    "    }\n"
+    "    gl_Position = gl_ProjectionMatrix * eyePos;\n"
+    "}\n";
+
+// ʵλĽǵ (1) * ߳ + ʵģˮĲ waterWaveHeight ͬ
+static const char* INSTANCE_VERTEX_SHADER =
+    "attribute vec3 aPosition;\n"
+    "attribute vec2 aCode;\n"
+    "attribute vec3 aInstance;\n"
+    "attribute vec2 aInstanceCode;\n"   // x: ɫ, y: 
+    "uniform float uQuantum;\n"
+    "uniform float uHalfSize;\n"
+    "uniform float uTime;\n"
+    "void main() {\n"
+    "    vec3 center = aInstance * uQuantum;\n"
+    "    if (mod(aInstanceCode.y, 2.0) >= 1.0) {\n"
+    "        center.y += sin(center.x * 0.5 + uTime * 2.0) * 0.25 + cos(center.z * 0.3 + uTime * 1.5) * 0.25;\n"
+    "    }\n"
+    "    vec4 eyePos = gl_ModelViewMatrix * vec4(center + aPosition * uHalfSize, 1.0);\n"
+    "    lightVertex(eyePos, faceNormal(aCode.x), paletteColor(aInstanceCode.x));\n"
+    "    gl_Position = gl_ProjectionMatrix * eyePos;\n"
+    "}\n";
+
+// ȺͬһʵƣaCrowd = (x, z, yaw, phase)
+// uPart ǲڵڵı任任ֱ 3x3
+//  Models.cpp е faceBrowOffset / faceGlintPosition / breathScaleAt ͬ
+// 任˳ glTranslatef + glRotatef + glScalef(1, breath, 1) ͬ߰תñ任
+static const char* CROWD_VERTEX_SHADER =
+    "attribute vec3 aPosition;\n"
+    "attribute vec2 aCode;\n"
+    "attribute vec4 aCrowd;\n"
+    "uniform vec3 uOrigin;\n"
+    "uniform float uQuantum;\n"
+    "uniform float uTime;\n"
+    "uniform mat4 uPart;\n"
+    "void main() {\n"
+    "    float t = uTime + aCrowd.w;\n"
+    "    float tags = floor(aCode.x / 8.0);\n"
+    "    vec3 p = (uPart * vec4(uOrigin + aPosition * uQuantum, 1.0)).xyz;\n"
+    "    if (mod(tags, 2.0) >= 1.0) {\n"
+    "        p.y += abs(sin(t * 4.0)) * 0.2;\n"
+    "    }\n"
+    "    if (mod(floor(tags * 0.5), 2.0) >= 1.0) {\n"
+    "        float scan = -1.5 + mod(t * 2.5, 3.5);\n"
+    "        if (!((scan >= -1.3 && scan <= -0.2) || (scan >= 0.2 && scan <= 1.3))) {\n"
+    "            gl_Position = vec4(2.0, 2.0, 2.0, 1.0);\n"   // ɲüռһ
+    "            vColor = vec4(0.0);\n"
+    "            vFogDepth = 0.0;\n"
+    "            return;\n"
+    "        }\n"
+    "        p.x += scan;\n"
+    "    }\n"
+    "    float breath = 1.0 + sin(t * 2.0) * 0.01;\n"
+    "    vec3 n = mat3(uPart[0].xyz, uPart[1].xyz, uPart[2].xyz) * faceNormal(aCode.x);\n"
+    "    p.y *= breath;\n"
+    "    n.y /= breath;\n"
+    "    float c = cos(aCrowd.z), s = sin(aCrowd.z);\n"
+    "    vec3 world = vec3(c * p.x + s * p.z + aCrowd.x, p.y, -s * p.x + c * p.z + aCrowd.y);\n"
+    "    vec3 normal = vec3(c * n.x + s * n.z, n.y, -s * n.x + c * n.z);\n"
+    "    vec4 eyePos = gl_ModelViewMatrix * vec4(world, 1.0);\n"
+    "    lightVertex(eyePos, normal, paletteColor(aCode.y));\n"
+    "    gl_Position = gl_ProjectionMatrix * eyePos;\n"
+    "}\n";
+
+// ֵΣaGlyph = (ĸ x,  rgb)λ =  + (x, 0, uNameZ)
+// ɫ VoxelFont.cpp  glyphShade ͬĹϣҲλͬع uLit = 0 Ļ֤
+// aLight Ǻ決ķ * AO
+static const char* GLYPH_VERTEX_SHADER =
+    "attribute vec3 aPosition;\n"
+    "attribute vec3 aCenter;\n"
+    "attribute vec4 aGlyph;\n"
+    "attribute float aLight;\n"
+    "uniform float uNameZ;\n"
+    "uniform float uLit;\n"
+    "float mod289(float x) { return x - floor(x / 289.0) * 289.0; }\n"
+    "float permute(float x) { return mod289((34.0 * x + 1.0) * x); }\n"
+    "float glyphDither(vec3 p) {\n"
+    "    vec3 c = floor(p * 4.0 + 0.5);\n"
+    "    float h = permute(mod289(c.x));\n"
+    "    h = permute(mod289(h + mod289(c.y)));\n"
+    "    h = permute(mod289(h + mod289(c.z)));\n"
+    "    return h / 289.0;\n"
+    "}\n"
+    "void main() {\n"
+    "    vec3 offset = vec3(aGlyph.x, 0.0, uNameZ);\n"
+    "    vec3 center = aCenter + offset;\n"
+    "    float factor = (1.0 + 0.6 * (aCenter.y / 5.0)) * (0.5 + 0.5 * (aCenter.z / 0.5))\n"
+    "        + (glyphDither(center) - 0.5) * 0.06;\n"
+    "    vec3 color = min(sqrt(max(aGlyph.yzw * factor, 0.0)), 1.0);\n"
+    "    vec4 eyePos = gl_ModelViewMatrix * vec4(aPosition + offset, 1.0);\n"
+    "    vColor = vec4(min(color * mix(1.0, aLight, uLit), 1.0), 1.0);\n"
+    "    vFogDepth = abs(eyePos.z);\n"
+    "    gl_Position = gl_ProjectionMatrix * eyePos;\n"
+    "}\n";
+
+static const char* FRAGMENT_SHADER =
+    "#version 120\n"
+    "varying vec4 vColor;\n"
+    "varying float vFogDepth;\n"
+    "void main() {\n"
+    "    float d = gl_Fog.density * vFogDepth;\n"
+    "    float f = clamp(exp(-d * d), 0.0, 1.0);\n"
+    "    gl_FragColor = vec4(mix(gl_Fog.color.rgb, vColor.rgb, f), vColor.a);\n"
+    "}\n";
+
+enum {
+    ATTRIB_POSITION,
+    ATTRIB_CODE,
+    ATTRIB_INSTANCE,
+    ATTRIB_INSTANCE_CODE,
+    // ɫԣ湲ñţ
+    ATTRIB_GLYPH_CENTER = ATTRIB_CODE,
+    ATTRIB_GLYPH = ATTRIB_INSTANCE,
+    ATTRIB_GLYPH_LIGHT = ATTRIB_INSTANCE_CODE
+};
+
+static const char* const ATTRIBUTE_NAMES[] = { "aPosition", "aCode", "aInstance", "aInstanceCode", nullptr };
+static const char* const CROWD_ATTRIBUTE_NAMES[] = { "aPosition", "aCode", "aCrowd", nullptr };
+static const char* const GLYPH_ATTRIBUTE_NAMES[] = { "aPosition", "aCenter", "aGlyph", "aLight", nullptr };
+
+const char* renderPathName(RenderPath path) {
+    switch (path) {
+    case RENDER_PATH_IMMEDIATE: return "immediate";
+    case RENDER_PATH_PACKED: return "packed";
+    }
+    return "unknown";
+}
+
+VoxelRenderer::VoxelRenderer()
+    : meshProgram(0), instanceProgram(0), crowdProgram(0), glyphProgram(0),
+      meshOrigin(-1), meshQuantum(-1), meshPalette(-1),
+      instQuantum(-1), instHalfSize(-1), instTime(-1), instPalette(-1),
+      crowdOrigin(-1), crowdQuantum(-1), crowdTime(-1), crowdPart(-1), crowdPalette(-1),
+      glyphNameZ(-1), glyphLit(-1),
+      paletteTexture(0), cubeBuffer(0), crowdBuffer(0), glyphTextBuffer(0), glyphZ(0.0f), bufferBytes(0) {}
+
+bool VoxelRenderer::init() {
+    if (!loadGLExtensions()) return false;
+
+    std::string meshSource = std::string(SHADER_COMMON) + MESH_VERTEX_SHADER;
+    std::string instanceSource = std::string(SHADER_COMMON) + INSTANCE_VERTEX_SHADER;
+    std::string crowdSource = std::string(SHADER_COMMON) + CROWD_VERTEX_SHADER;
+    std::string glyphSource = std::string(SHADER_COMMON) + GLYPH_VERTEX_SHADER;
+    GLuint mesh = buildShaderProgram(meshSource.c_str(), FRAGMENT_SHADER, ATTRIBUTE_NAMES);
+    GLuint inst = buildShaderProgram(instanceSource.c_str(), FRAGMENT_SHADER, ATTRIBUTE_NAMES);
+    GLuint crowd = buildShaderProgram(crowdSource.c_str(), FRAGMENT_SHADER, CROWD_ATTRIBUTE_NAMES);
+    GLuint glyph = buildShaderProgram(glyphSource.c_str(), FRAGMENT_SHADER, GLYPH_ATTRIBUTE_NAMES);
+    if (!mesh || !inst || !crowd || !glyph) return false;
+
+    meshOrigin = glGetUniformLocation(mesh, "uOrigin");
+    meshQuantum = glGetUniformLocation(mesh, "uQuantum");
+    meshPalette = glGetUniformLocation(mesh, "uPalette");
+    meshBaked = glGetUniformLocation(mesh, "uBaked");
+    instQuantum = glGetUniformLocation(inst, "uQuantum");
+    instHalfSize = glGetUniformLocation(inst, "uHalfSize");
+    instTime = glGetUniformLocation(inst, "uTime");
+    instPalette = glGetUniformLocation(inst, "uPalette");
+    crowdOrigin = glGetUniformLocation(crowd, "uOrigin");
+    crowdQuantum = glGetUniformLocation(crowd, "uQuantum");
+    crowdTime = glGetUniformLocation(crowd, "uTime");
+    crowdPart = glGetUniformLocation(crowd, "uPart");
+    crowdPalette = glGetUniformLocation(crowd, "uPalette");
+    glyphNameZ = glGetUniformLocation(glyph, "uNameZ");
+    glyphLit = glGetUniformLocation(glyph, "uLit");
+
+    // ɫ壺256x1 ĸɫ glColor3f ȫͬ
+    glGenTextures(1, &paletteTexture);
+    glBindTexture(GL_TEXTURE_2D, paletteTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, Palette::MAX_COLORS, 1, 0, GL_RGBA, GL_FLOAT, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // λ壺24 㣬ǵΪ 1
+    static const int CUBE_CORNERS[6][4][3] = {
+        { { 1, -1, 1 }, { 1, -1, -1 }, { 1, 1, -1 }, { 1, 1, 1 } },
+        { { -1, -1, -1 }, { -1, -1, 1 }, { -1, 1, 1 }, { -1, 1, -1 } },
+        { { -1, 1, 1 }, { 1, 1, 1 }, { 1, 1, -1 }, { -1, 1, -1 } },
+        { { -1, -1, -1 }, { 1, -1, -1 }, { 1, -1, 1 }, { -1, -1, 1 } },
+        { { -1, -1, 1 }, { 1, -1, 1 }, { 1, 1, 1 }, { -1, 1, 1 } },
+        { { 1, -1, -1 }, { -1, -1, -1 }, { -1, 1, -1 }, { 1, 1, -1 } }
+    };
+    std::vector<PackedVertex> cube;
+    for (int f = 0; f < 6; ++f) {
+        for (int c = 0; c < 4; ++c) {
+            const int* s = CUBE_CORNERS[f][c];
+            cube.push_back({ (int16_t)s[0], (int16_t)s[1], (int16_t)s[2], (uint8_t)f, 0 });
+        }
+    }
+    glGenBuffers(1, &cubeBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, cubeBuffer);
+    glBufferData(GL_ARRAY_BUFFER, cube.size() * sizeof(PackedVertex), cube.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    bufferBytes += cube.size() * sizeof(PackedVertex);
+
+    // Ⱥʵÿ֡ϴֻϴɼģ
+    glGenBuffers(1, &crowdBuffer);
+    glGenBuffers(1, &glyphTextBuffer);
+
+    // û GL 3.2 ʱϴֱ glBufferSubData
+    if (!staging.init()) printf("staging ring unavailable, uploads use glBufferSubData\n");
+
+    meshProgram = mesh;
+    instanceProgram = inst;
+    crowdProgram = crowd;
+    glyphProgram = glyph;
+    return true;
+}
+
+// λáΧкͶ buffer
+void VoxelRenderer::describeChunk(const MeshChunk& chunk, GpuChunk& c) {
+    c.key = { chunk.key[0], chunk.key[1], chunk.key[2] };
+    for (int a = 0; a < 3; ++a) {
+        c.origin[a] = chunk.origin[a];
+        c.boundsMin[a] = chunk.boundsMin[a];
+        c.boundsMax[a] = chunk.boundsMax[a];
+    }
+    c.quantum = chunk.quantum;
+    c.voxelCount = chunk.voxelCount;
+    c.packedCount = (int)chunk.packed.size();
+    c.looseCount = (int)chunk.loose.size();
+}
+
+// һд c.bufferûлʱ½Сʱԭظ
+void VoxelRenderer::uploadChunk(const MeshChunk& chunk, GpuChunk& c) {
+    size_t packedBytes = chunk.packed.size() * sizeof(PackedVertex);
+    size_t looseBytes = chunk.loose.size() * sizeof(FloatVertex);
+    size_t oldBytes = (size_t)c.packedCount * sizeof(PackedVertex) + (size_t)c.looseCount * sizeof(FloatVertex);
+
+    describeChunk(chunk, c);
+
+    if (c.buffer == 0) {
+        glGenBuffers(1, &c.buffer);
+        oldBytes = 0;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, c.buffer);
+    if (oldBytes != packedBytes + looseBytes) {
+        glBufferData(GL_ARRAY_BUFFER, packedBytes + looseBytes, nullptr, GL_STATIC_DRAW);
+    }
+    if (packedBytes) glBufferSubData(GL_ARRAY_BUFFER, 0, packedBytes, chunk.packed.data());
+    if (looseBytes) glBufferSubData(GL_ARRAY_BUFFER, packedBytes, looseBytes, chunk.loose.data());
+    bufferBytes += (long long)(packedBytes + looseBytes) - (long long)oldBytes;
+}
+
+int VoxelRenderer::addMesh(const VoxelMeshData& mesh) {
+    GpuMesh gpu;
+    gpu.voxelCount = mesh.voxelCount();
+    gpu.baked = mesh.baked;
+
+    for (const auto& chunk : mesh.chunks) {
+        GpuChunk c = {};
+        uploadChunk(chunk, c);
+        gpu.chunks.push_back(c);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    meshes.push_back(gpu);
+    return (int)meshes.size() - 1;
+}
+
+int VoxelRenderer::updateMesh(int handle, const VoxelMeshData& rebuilt, const std::vector<ChunkKey>& dirty) {
+    GpuMesh& gpu = meshes[handle];
+    int uploaded = 0;
+
+    for (const ChunkKey& key : dirty) {
+        auto sameKey = [&key](const GpuChunk& c) { return c.key == key; };
+        auto existing = std::find_if(gpu.chunks.begin(), gpu.chunks.end(), sameKey);
+        const MeshChunk* fresh = nullptr;
+        for (const auto& chunk : rebuilt.chunks) {
+            if (chunk.key[0] == key.x && chunk.key[1] == key.y && chunk.key[2] == key.z) fresh = &chunk;
+        }
+
+        if (existing != gpu.chunks.end()) gpu.voxelCount -= existing->voxelCount;
+
+        if (fresh && existing != gpu.chunks.end()) {
+            uploadChunk(*fresh, *existing);
+        } else if (fresh) {
+            GpuChunk c = {};
+            uploadChunk(*fresh, c);
+            gpu.chunks.push_back(c);
+        } else if (existing != gpu.chunks.end()) {
+            // ȫɾ
+            bufferBytes -= (long long)existing->packedCount * sizeof(PackedVertex) +
+                (long long)existing->looseCount * sizeof(FloatVertex);
+            glDeleteBuffers(1, &existing->buffer);
+            gpu.chunks.erase(existing);
+            continue;
+        } else {
+            continue;
+        }
+        gpu.voxelCount += fresh->voxelCount;
+        ++uploaded;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return uploaded;
+}
+
+int VoxelRenderer::createMesh(bool baked) {
+    GpuMesh gpu;
+    gpu.voxelCount = 0;
+    gpu.baked = baked;
+    meshes.push_back(gpu);
+    return (int)meshes.size() - 1;
+}
+
+int VoxelRenderer::createGlyph() {
+    GpuGlyph gpu;
+    gpu.buffer = 0;
+    gpu.vertexCount = 0;
+    gpu.voxelCount = 0;
+    glyphs.push_back(gpu);
+    return (int)glyphs.size() - 1;
+}
+
+// ̣߳ƴ GPU ͬĲֻ֣߳ҪƬ
+void VoxelRenderer::queueMesh(int handle, VoxelMeshData&& mesh) {
+    std::vector<PendingUpload> items(mesh.chunks.size());
+    for (size_t i = 0; i < mesh.chunks.size(); ++i) {
+        const MeshChunk& chunk = mesh.chunks[i];
+        PendingUpload& item = items[i];
+        size_t packedBytes = chunk.packed.size() * sizeof(PackedVertex);
+        size_t looseBytes = chunk.loose.size() * sizeof(FloatVertex);
+
+        item.mesh = handle;
+        item.glyph = -1;
+        item.chunk = {};
+        describeChunk(chunk, item.chunk);
+        item.voxelCount = chunk.voxelCount;
+        item.data.resize(packedBytes + looseBytes);
+        if (packedBytes) memcpy(item.data.data(), chunk.packed.data(), packedBytes);
+        if (looseBytes) memcpy(item.data.data() + packedBytes, chunk.loose.data(), looseBytes);
+        item.buffer = 0;
+        item.written = 0;
+    }
+    mesh.chunks.clear();
+
+    std::lock_guard<std::mutex> guard(queueLock);
+    for (auto& item : items) queue.push_back(std::move(item));
+}
+
+//  VoxelFont Ļ︴һ
+void VoxelRenderer::queueGlyph(int handle, const std::vector<GlyphVertex>& vertices, int voxelCount) {
+    PendingUpload item;
+    item.mesh = -1;
+    item.glyph = handle;
+    item.chunk = {};
+    item.chunk.looseCount = (int)vertices.size();
+    item.voxelCount = voxelCount;
+    item.data.resize(vertices.size() * sizeof(GlyphVertex));
+    if (!vertices.empty()) memcpy(item.data.data(), vertices.data(), item.data.size());
+    item.buffer = 0;
+    item.written = 0;
+
+    std::lock_guard<std::mutex> guard(queueLock);
+    queue.push_back(std::move(item));
+}
+
+bool VoxelRenderer::uploadsPending() const {
+    std::lock_guard<std::mutex> guard(queueLock);
+    return !queue.empty();
+}
+
+// ÿƬ UPLOAD_SLICE ֽڣּ֡ꣻݴ滷˾һ֡
+size_t VoxelRenderer::processUploads(size_t byteBudget) {
+    const size_t UPLOAD_SLICE = StagingRing::SIZE / 16;
+    staging.retire();
+
+    size_t sent = 0;
+    while (sent < byteBudget) {
+        PendingUpload* item;
+        {
+            // ֻ߳ĩβ׷ӣԪصĵַ
+            std::lock_guard<std::mutex> guard(queueLock);
+            if (queue.empty()) break;
+            item = &queue.front();
+        }
+
+        size_t total = item->data.size();
+        if (item->buffer == 0) {
+            glGenBuffers(1, &item->buffer);
+            glBindBuffer(GL_ARRAY_BUFFER, item->buffer);
+            glBufferData(GL_ARRAY_BUFFER, total, nullptr, GL_STATIC_DRAW);
+            bufferBytes += total;
+        }
+        if (item->written < total) {
+            size_t n = std::min(total - item->written, UPLOAD_SLICE);
+            const char* src = item->data.data() + item->written;
+            if (staging.ready()) {
+                if (!staging.upload(item->buffer, item->written, src, n)) break;
+            } else {
+                glBindBuffer(GL_ARRAY_BUFFER, item->buffer);
+                glBufferSubData(GL_ARRAY_BUFFER, item->written, n, src);
+            }
+            item->written += n;
+            sent += n;
+        }
+        if (item->written < total) continue;
+
+        finishUpload(*item);
+        std::lock_guard<std::mutex> guard(queueLock);
+        queue.pop_front();
+    }
+    staging.endFrame();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    g_frameStats.uploadBytes += sent;
+    return sent;
+}
+
+// ȫдŹҵϣ֮֡ͻử
+void VoxelRenderer::finishUpload(PendingUpload& item) {
+    if (item.mesh >= 0) {
+        GpuMesh& gpu = meshes[item.mesh];
+        item.chunk.buffer = item.buffer;
+        gpu.chunks.push_back(item.chunk);
+        gpu.voxelCount += item.voxelCount;
+        return;
+    }
+
+    GpuGlyph& gpu = glyphs[item.glyph];
+    if (gpu.buffer) {
+        glDeleteBuffers(1, &gpu.buffer);
+        bufferBytes -= (long long)gpu.vertexCount * sizeof(GlyphVertex);
+    }
+    gpu.buffer = item.buffer;
+    gpu.vertexCount = item.chunk.looseCount;
+    gpu.voxelCount = item.voxelCount;
+}
+
+int VoxelRenderer::addInstances(const std::vector<PackedInstance>& instances, float quantum, float voxelSize) {
+    GpuInstances gpu;
+    gpu.count = (int)instances.size();
+    gpu.quantum = quantum;
+    gpu.voxelSize = voxelSize;
+
+    glGenBuffers(1, &gpu.buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, gpu.buffer);
+    glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(PackedInstance), instances.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    bufferBytes += instances.size() * sizeof(PackedInstance);
+
+    instanceSets.push_back(gpu);
+    return (int)instanceSets.size() - 1;
+}
+
+void VoxelRenderer::syncPalette() {
+    float rgba[Palette::MAX_COLORS * 4];
+    if (colors.takeChanges(rgba)) {
+        glBindTexture(GL_TEXTURE_2D, paletteTexture);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, Palette::MAX_COLORS, 1, GL_RGBA, GL_FLOAT, rgba);
+    }
+}
+
+void VoxelRenderer::bindPalette(GLuint program) {
+    syncPalette();
+    glBindTexture(GL_TEXTURE_2D, paletteTexture);
+    glUseProgram(program);
+    GLint location = program == meshProgram ? meshPalette : program == instanceProgram ? instPalette : crowdPalette;
+    glUniform1i(location, 0);
+}
+
+// Χȫĳüƽ༴ɼ
+void VoxelRenderer::cullChunks(const GpuMesh& mesh, JobSystem* jobs) {
+    float planes[6][4];
+    currentFrustumPlanes(planes);
+
+    visible.assign(mesh.chunks.size(), 1);
+    auto test = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            const GpuChunk& c = mesh.chunks[i];
+            for (int p = 0; p < 6; ++p) {
+                const float* pl = planes[p];
+                float x = pl[0] > 0 ? c.boundsMax[0] : c.boundsMin[0];
+                float y = pl[1] > 0 ? c.boundsMax[1] : c.boundsMin[1];
+                float z = pl[2] > 0 ? c.boundsMax[2] : c.boundsMin[2];
+                if (pl[0] * x + pl[1] * y + pl[2] * z + pl[3] < 0) {
+                    visible[i] = 0;
+                    break;
+                }
+            }
+        }
+    };
+
+    if (jobs) jobs->parallelFor(0, (int)mesh.chunks.size(), 16, test);
+    else test(0, (int)mesh.chunks.size());
+}
+
+// һ飨ֺ͸㲿ָһεãinstances > 0 ʱʵ
+void VoxelRenderer::drawChunk(const GpuChunk& c, GLint originLocation, GLint quantumLocation, int instances, bool baked) {
+    glBindBuffer(GL_ARRAY_BUFFER, c.buffer);
+    glUniform3f(originLocation, c.origin[0], c.origin[1], c.origin[2]);
+
+    int repeat = instances > 0 ? instances : 1;
+    if (c.packedCount) {
+        glUniform1f(quantumLocation, c.quantum);
+        glVertexAttribPointer(ATTRIB_POSITION, 3, GL_SHORT, GL_FALSE, sizeof(PackedVertex), (const void*)0);
+        glVertexAttribPointer(ATTRIB_CODE, 2, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(PackedVertex), (const void*)6);
+        if (instances > 0) glDrawArraysInstanced(GL_QUADS, 0, c.packedCount, instances);
+        else glDrawArrays(GL_QUADS, 0, c.packedCount);
+        g_frameStats.drawCalls++;
+    }
+    if (c.looseCount) {
+        size_t offset = c.packedCount * sizeof(PackedVertex);
+        glUniform1f(quantumLocation, 1.0f);
+        glVertexAttribPointer(ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(FloatVertex), (const void*)offset);
+        glVertexAttribPointer(ATTRIB_CODE, 2, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(FloatVertex), (const void*)(offset + 12));
+        if (instances > 0) glDrawArraysInstanced(GL_QUADS, 0, c.looseCount, instances);
+        else glDrawArrays(GL_QUADS, 0, c.looseCount);
+        g_frameStats.drawCalls++;
+    }
+
+    g_frameStats.vertexBytes += repeat * ((long long)c.packedCount * sizeof(PackedVertex) +
+        (long long)c.looseCount * sizeof(FloatVertex));
+    long long vertices = (long long)repeat * (c.packedCount + c.looseCount);
+    if (baked) g_frameStats.bakedVertices += vertices;
+    else g_frameStats.litVertices += vertices;
+}
+
+void VoxelRenderer::drawMesh(int handle, JobSystem* jobs) {
+    const GpuMesh& mesh = meshes[handle];
+    cullChunks(mesh, jobs);
+
+    bindPalette(meshProgram);
+    glUniform1f(meshBaked, mesh.baked ? 1.0f : 0.0f);
+    glEnableVertexAttribArray(ATTRIB_POSITION);
+    glEnableVertexAttribArray(ATTRIB_CODE);
+
+    for (size_t i = 0; i < mesh.chunks.size(); ++i) {
+        const GpuChunk& c = mesh.chunks[i];
+        if (!visible[i]) {
+            g_frameStats.voxelsCulled += c.voxelCount;
+            continue;
+        }
+
+        drawChunk(c, meshOrigin, meshQuantum, 0, mesh.baked);
+        g_frameStats.voxelsSubmitted += c.voxelCount;
+    }
+    g_frameStats.floatPathBytes += mesh.voxelCount * FLOAT_CUBE_BYTES;
+
+    glDisableVertexAttribArray(ATTRIB_POSITION);
+    glDisableVertexAttribArray(ATTRIB_CODE);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void VoxelRenderer::setGlyphText(const std::vector<GlyphInstance>& letters, float z) {
+    std::vector<GlyphInstance> sorted(letters);
+    std::stable_sort(sorted.begin(), sorted.end(),
+        [](const GlyphInstance& a, const GlyphInstance& b) { return a.glyph < b.glyph; });
+
+    std::vector<float> data;
+    data.reserve(sorted.size() * 4);
+    glyphRanges.clear();
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        const GlyphInstance& g = sorted[i];
+        if (glyphRanges.empty() || glyphRanges.back().glyph != g.glyph) {
+            glyphRanges.push_back({ g.glyph, (int)i, 0 });
+        }
+        glyphRanges.back().count++;
+        data.insert(data.end(), { g.x, g.r, g.g, g.b });
+    }
+    glyphZ = z;
+
+    glBindBuffer(GL_ARRAY_BUFFER, glyphTextBuffer);
+    glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(float), data.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void VoxelRenderer::drawGlyphs(bool lit) {
+    const GLsizei stride = sizeof(GlyphVertex);
+    const GLsizei instanceStride = 4 * sizeof(float);
+    if (glyphRanges.empty()) return;
+
+    glUseProgram(glyphProgram);
+    glUniform1f(glyphNameZ, glyphZ);
+    glUniform1f(glyphLit, lit ? 1.0f : 0.0f);
+    glEnableVertexAttribArray(ATTRIB_POSITION);
+    glEnableVertexAttribArray(ATTRIB_GLYPH_CENTER);
+    glEnableVertexAttribArray(ATTRIB_GLYPH_LIGHT);
+    glEnableVertexAttribArray(ATTRIB_GLYPH);
+    glVertexAttribDivisor(ATTRIB_GLYPH, 1);
+
+    for (const GlyphRange& range : glyphRanges) {
+        const GpuGlyph& glyph = glyphs[range.glyph];
+        if (glyph.buffer == 0) continue; // ϴ
+
+        glBindBuffer(GL_ARRAY_BUFFER, glyph.buffer);
+        glVertexAttribPointer(ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, stride, (const void*)0);
+        glVertexAttribPointer(ATTRIB_GLYPH_CENTER, 3, GL_FLOAT, GL_FALSE, stride, (const void*)(3 * sizeof(float)));
+        glVertexAttribPointer(ATTRIB_GLYPH_LIGHT, 1, GL_FLOAT, GL_FALSE, stride, (const void*)(6 * sizeof(float)));
+        glBindBuffer(GL_ARRAY_BUFFER, glyphTextBuffer);
+        glVertexAttribPointer(ATTRIB_GLYPH, 4, GL_FLOAT, GL_FALSE, instanceStride,
+            (const void*)((size_t)range.first * instanceStride));
+
+        glDrawArraysInstanced(GL_QUADS, 0, glyph.vertexCount, range.count);
+
+        // פԴ棬ÿĸֻ 16 ֽڵʵ
+        g_frameStats.drawCalls++;
+        g_frameStats.voxelsSubmitted += (long long)glyph.voxelCount * range.count;
+        g_frameStats.vertexBytes += (long long)glyph.vertexCount * stride + (long long)range.count * instanceStride;
+        g_frameStats.floatPathBytes += (long long)glyph.voxelCount * range.count * FLOAT_CUBE_BYTES;
+        g_frameStats.bakedVertices += (long long)glyph.vertexCount * range.count;
+    }
+
+    glVertexAttribDivisor(ATTRIB_GLYPH, 0);
+    glDisableVertexAttribArray(ATTRIB_POSITION);
+    glDisableVertexAttribArray(ATTRIB_GLYPH_CENTER);
+    glDisableVertexAttribArray(ATTRIB_GLYPH_LIGHT);
+    glDisableVertexAttribArray(ATTRIB_GLYPH);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(0);
+}
+
+void VoxelRenderer::drawInstances(int handle, float time) {
+    const GpuInstances& set = instanceSets[handle];
+
+    bindPalette(instanceProgram);
+    glUniform1f(instQuantum, set.quantum);
+    glUniform1f(instHalfSize, set.voxelSize * 0.5f);
+    glUniform1f(instTime, time);
+
+    glEnableVertexAttribArray(ATTRIB_POSITION);
+    glEnableVertexAttribArray(ATTRIB_CODE);
+    glEnableVertexAttribArray(ATTRIB_INSTANCE);
+    glEnableVertexAttribArray(ATTRIB_INSTANCE_CODE);
+
+    glBindBuffer(GL_ARRAY_BUFFER, cubeBuffer);
+    glVertexAttribPointer(ATTRIB_POSITION, 3, GL_SHORT, GL_FALSE, sizeof(PackedVertex), (const void*)0);
+    glVertexAttribPointer(ATTRIB_CODE, 2, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(PackedVertex), (const void*)6);
+
+    glBindBuffer(GL_ARRAY_BUFFER, set.buffer);
+    glVertexAttribPointer(ATTRIB_INSTANCE, 3, GL_SHORT, GL_FALSE, sizeof(PackedInstance), (const void*)0);
+    glVertexAttribPointer(ATTRIB_INSTANCE_CODE, 2, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(PackedInstance), (const void*)6);
+    glVertexAttribDivisor(ATTRIB_INSTANCE, 1);
+    glVertexAttribDivisor(ATTRIB_INSTANCE_CODE, 1);
+
+    glDrawArraysInstanced(GL_QUADS, 0, 24, set.count);
+
+    glVertexAttribDivisor(ATTRIB_INSTANCE, 0);
+    glVertexAttribDivisor(ATTRIB_INSTANCE_CODE, 0);
+    glDisableVertexAttribArray(ATTRIB_POSITION);
+    glDisableVertexAttribArray(ATTRIB_CODE);
+    glDisableVertexAttribArray(ATTRIB_INSTANCE);
+    glDisableVertexAttribArray(ATTRIB_INSTANCE_CODE);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    //  24 㳣פ棬ÿʵʵʶȡֻ 8 ֽʵ
+    g_frameStats.drawCalls++;
+    g_frameStats.voxelsSubmitted += set.count;
+    g_frameStats.vertexBytes += (long long)set.count * sizeof(PackedInstance) + 24 * sizeof(PackedVertex);
+    g_frameStats.floatPathBytes += set.count * FLOAT_CUBE_BYTES;
+    g_frameStats.litVertices += 24LL * set.count;
+}
+
+void VoxelRenderer::drawCrowd(const int* handles, const float* const* partMatrices, int handleCount,
+    const CrowdInstance* instances, int count, float time) {
+    if (count <= 0) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, crowdBuffer);
+    glBufferData(GL_ARRAY_BUFFER, count * sizeof(CrowdInstance), instances, GL_STREAM_DRAW);
+
+    bindPalette(crowdProgram);
+    glUniform1f(crowdTime, time);
+
+    glEnableVertexAttribArray(ATTRIB_POSITION);
+    glEnableVertexAttribArray(ATTRIB_CODE);
+    glEnableVertexAttribArray(ATTRIB_INSTANCE);
+    glVertexAttribPointer(ATTRIB_INSTANCE, 4, GL_FLOAT, GL_FALSE, sizeof(CrowdInstance), (const void*)0);
+    glVertexAttribDivisor(ATTRIB_INSTANCE, 1);
+
+    for (int h = 0; h < handleCount; ++h) {
+        const GpuMesh& mesh = meshes[handles[h]];
+        glUniformMatrix4fv(crowdPart, 1, GL_FALSE, partMatrices[h]);
+        for (const auto& c : mesh.chunks) {
+            drawChunk(c, crowdOrigin, crowdQuantum, count, false);
+        }
+        g_frameStats.voxelsSubmitted += (long long)mesh.voxelCount * count;
+        g_frameStats.floatPathBytes += (long long)mesh.voxelCount * count * FLOAT_CUBE_BYTES;
+    }
+    g_frameStats.vertexBytes += (long long)count * sizeof(CrowdInstance);
+
+    glVertexAttribDivisor(ATTRIB_INSTANCE, 0);
+    glDisableVertexAttribArray(ATTRIB_POSITION);
+    glDisableVertexAttribArray(ATTRIB_CODE);
+    glDisableVertexAttribArray(ATTRIB_INSTANCE);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
\ No newline at end of file
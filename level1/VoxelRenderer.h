@@ -0,0 +1,178 @@
+#ifndef VOXEL_RENDERER_H
+#define VOXEL_RENDERER_H
+
+#include <deque>
+#include <mutex>
+#include <vector>
+#include "GLExt.h"
+#include "StagingRing.h"
+#include "VoxelMesh.h"
+
+class JobSystem;
+struct CrowdInstance;
+
+// һĸglyph  createGlyph() ľx ĸģrgb ǻ
+struct GlyphInstance {
+    int glyph;
+    float x;
+    float r, g, b;
+};
+
+// ·ԭ𷽿 drawCube/ʵ
+enum RenderPath {
+    RENDER_PATH_IMMEDIATE,
+    RENDER_PATH_PACKED
+};
+
+const char* renderPathName(RenderPath path);
+
+// GPU ˵Ⱦ
+// - ̬ģͣVoxelMeshData ÿһ VBOǰ׶޳
+// - ̬ģͣһλ + ÿ 8 ֽڵʵݣglDrawArraysInstanced
+// - ɫ init() Ĺ̶߹պ EXP2 ֱӶȡ gl_LightSource / gl_Fog
+//   ·ͬһ֡
+// - ̬ģͿڽʱ決գVoxelMeshData::bakedֻ
+// - ֣ÿһɫɫλͬһεĸһʵ
+// - ʱϴУ̷߳룬߳ÿֽ֡Ԥ㾭ݴ滷ϴ鴫Ϳʼ
+class VoxelRenderer {
+public:
+    VoxelRenderer();
+
+    //  GL չɫҪ GL ģʧʱ ready() Ϊ false
+    bool init();
+    bool ready() const { return meshProgram != 0; }
+
+    Palette& palette() { return colors; }
+
+    // ϴ̬񣬷ؾ
+    int addMesh(const VoxelMeshData& mesh);
+
+    // ȼأrebuilt  buildVoxelMeshChunks  dirty ؽ
+    // dirty ϴrebuilt ûеɾĻ岻ϴ
+    int updateMesh(int handle, const VoxelMeshData& rebuilt, const std::vector<ChunkKey>& dirty);
+
+    // õǰģͼ/ͶӰƣʱ޳
+    void drawMesh(int handle, JobSystem* jobs);
+
+    // ֵ֣letters ηŽһʵ壬z ֵ z 0
+    // ֻҪ⼸ʮֽڣ񲻶
+    void setGlyphText(const std::vector<GlyphInstance>& letters, float z);
+    // ÿõһ glDrawArraysInstancedûϴβ
+    // lit Ϊ false ʱ˺決Ĺգ glyphShade ɫع drawCube Աã
+    void drawGlyphs(bool lit = true);
+
+    // ϴУ߳Ƚյľ߳̽ queue*()̰߳ȫ
+    // ߳ÿ֡ processUploads()û鲻վճ draw
+    int createMesh(bool baked);
+    int createGlyph();
+    void queueMesh(int handle, VoxelMeshData&& mesh);
+    void queueGlyph(int handle, const std::vector<GlyphVertex>& vertices, int voxelCount);
+
+    // ϴԼ byteBudget ֽڣһƬʵϴֽ
+    size_t processUploads(size_t byteBudget);
+    bool uploadsPending() const;
+    bool stagedUploads() const { return staging.ready(); }
+
+    // ϴʵݣquantum  PackedInstance λõλvoxelSize Ƿ߳
+    int addInstances(const std::vector<PackedInstance>& instances, float quantum, float voxelSize);
+
+    void drawInstances(int handle, float time);
+
+    // Ⱥhandles Ϊһ instances ı任ʱλһ
+    // ÿһ glDrawArraysInstanced޹أ
+    // partMatrices[i] ǵ i ڲľ򣩣ǰģͼڵ
+    void drawCrowd(const int* handles, const float* const* partMatrices, int handleCount,
+        const CrowdInstance* instances, int count, float time);
+
+    // ͳã
+    int meshVoxelCount(int handle) const { return meshes[handle].voxelCount; }
+
+    // ж/ʵռõԴ
+    long long gpuBytes() const { return bufferBytes; }
+
+private:
+    struct GpuChunk {
+        ChunkKey key;
+        GLuint buffer;
+        float origin[3];
+        float quantum;
+        float boundsMin[3], boundsMax[3];
+        int voxelCount;
+        int packedCount;        // ڻ忪ͷ
+        int looseCount;         // 㶥ڴ
+    };
+
+    struct GpuMesh {
+        std::vector<GpuChunk> chunks;
+        int voxelCount;
+        bool baked;             // ɫѺ決
+    };
+
+    struct GpuGlyph {
+        GLuint buffer;
+        int vertexCount;
+        int voxelCount;
+    };
+
+    // ʵͬһεһ
+    struct GlyphRange {
+        int glyph;
+        int first;
+        int count;
+    };
+
+    struct GpuInstances {
+        GLuint buffer;
+        int count;
+        float quantum;
+        float voxelSize;
+    };
+
+    // һһһΣdata  GPU ֽͬ
+    struct PendingUpload {
+        int mesh;               // ̬-1 ʾ
+        int glyph;
+        GpuChunk chunk;         // Ϣbuffer ̷߳䣩
+        int voxelCount;
+        std::vector<char> data;
+        GLuint buffer;
+        size_t written;         // Ѿд buffer ֽ
+    };
+
+    static void describeChunk(const MeshChunk& chunk, GpuChunk& c);
+    void uploadChunk(const MeshChunk& chunk, GpuChunk& c);
+    void finishUpload(PendingUpload& item);
+    void syncPalette();
+    void bindPalette(GLuint program);
+    void cullChunks(const GpuMesh& mesh, JobSystem* jobs);
+    void drawChunk(const GpuChunk& chunk, GLint originLocation, GLint quantumLocation, int instances, bool baked);
+
+    GLuint meshProgram;
+    GLuint instanceProgram;
+    GLuint crowdProgram;
+    GLuint glyphProgram;
+    GLint meshOrigin, meshQuantum, meshPalette, meshBaked;
+    GLint instQuantum, instHalfSize, instTime, instPalette;
+    GLint crowdOrigin, crowdQuantum, crowdTime, crowdPart, crowdPalette;
+    GLint glyphNameZ, glyphLit;
+
+    GLuint paletteTexture;
+    GLuint cubeBuffer;          // λ 24 
+    GLuint crowdBuffer;         // ÿ֡ĿɼȺʵ
+    GLuint glyphTextBuffer;     // ֵĸʵ
+
+    Palette colors;
+    std::vector<GpuMesh> meshes;
+    std::vector<GpuGlyph> glyphs;
+    std::vector<GlyphRange> glyphRanges;
+    float glyphZ;
+    std::vector<GpuInstances> instanceSets;
+    std::vector<char> visible;  // cullChunks Ľ
+    long long bufferBytes;
+
+    StagingRing staging;
+    mutable std::mutex queueLock;
+    std::deque<PendingUpload> queue; // ֻ߳ĩβ׷ӣֻ߳ͷȡ
+};
+
+#endif // VOXEL_RENDERER_H
\ No newline at end of file
@@ -1,30 +1,191 @@
 #include <GL/glut.h>
 #include <vector>
 #include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
 
 #include "Voxel.h"
 #include "Utils.h"
 #include "Models.h"
 #include "Camera.h"
+#include "JobSystem.h"
+#include "Benchmark.h"
+#include "CpuRender.h"
+#include "SceneParams.h"
+#include "SoftwareRenderer.h"
+#include "VoxelRenderer.h"
+#include "Stats.h"
+#include "Crowd.h"
+#include "VoxelQuery.h"
+#include "Input.h"
+#include "SceneGraph.h"
+#include "SceneFile.h"
+#include "FileWatcher.h"
+#include "VoxelFont.h"
+#include "StatsHud.h"
+#include "DynamicResolution.h"
+#include "SceneState.h"
 
 // --- ȫֱ ---
 Camera g_camera;
-std::vector<Voxel> selfPortraitModel;
+VoxelSpan<Voxel> selfPortraitModel;   // ں決ֻ
 std::vector<Voxel> landscapeModel;
-std::vector<VoxelWatch> watchModel;
-std::vector<VoxelFace> faceModel;
+VoxelSpan<VoxelWatch> watchModel;     // ں決ֻ
 std::vector<VoxelName> nameModel;
-float g_nameYOffset = 0.0f; // ¸Ķ
+
+// ״̬صֻ¼ / ̧display() ͷÿ֡һ
+InputState g_input;
+float g_lastTickTime = -1.0f;
+double g_pendingInputMs = -1.0; // ѱûʾ簴¼ʱ
+const float MAX_TICK_DELTA = 0.1f; // ٺָʱһ֡ƶ 0.1 ľ
+
+// GPU · 'p' ԭ drawCube ·л
+VoxelRenderer g_voxelRenderer;
+RenderPath g_renderPath = RENDER_PATH_PACKED;
+int g_landscapeMesh = -1;
+int g_waterInstances = -1;
+
+//  = Ի + ֱ + Ⱥģʽ» N ݣĬ 1 ݣԭǸˣ
+Crowd g_crowd;
+FaceParts g_faceParts;
+const int FIGURE_PARTS = 5;
+int g_figureMeshes[FIGURE_PARTS] = { -1, -1, -1, -1, -1 };
+std::map<char, int> g_glyphHandles; // õȾľ
+
+// ͼÿڵ󻺴ֻб任ı䣨ָȣʱ
+// ʱÿڵϴһ ͼ *  󣬲 push / translate / scale
+SceneGraph g_scene;
+struct SceneNodes {
+    int landscape, water, figure, watch, face, name;
+} g_nodes;
+float g_viewMatrix[16]; // ֡ͼ
+
+// ̬ײ / ʰȡݣȡֹֻ̬Ⱥĵһˣ
+VoxelQuery g_collision;
+struct CollisionPart {
+    const char* name;
+    int firstBox;
+};
+std::vector<CollisionPart> g_collisionParts;
+
+// ļʱڹ߳ɸĶģֻͣؽϴ仯
+const char* g_scenePath = "scene.txt";
+SceneDesc g_sceneDesc;
+FileWatcher g_sceneWatcher;
+
+// һȼأ߳д task ֶΣ߳ task ɺӦ
+struct SceneReload {
+    TaskHandle task;
+    SceneDesc desc;
+    bool ok = false;
+    std::string error;
+    bool landscapeChanged = false, nameChanged = false, figureMoved = false;
+    std::vector<Voxel> landscape;
+    std::vector<ChunkKey> dirtyChunks;
+    VoxelMeshData rebuiltChunks;
+    std::vector<VoxelName> name;
+    VoxelQuery collision;
+    std::vector<CollisionPart> collisionParts;
+    double startMs = 0.0;
+    double workerMs = 0.0;
+};
+std::unique_ptr<SceneReload> g_reload;
+bool g_reloadQueued = false; // عļֱ棬ɺټһ
+
+// أģɡײڹ߳init() ֻύͷ
+// ߳ÿ֡ѾɵģͻȫֱԤϴһ飬ڴӵһ֡Ӧ
+struct ModelLoad {
+    TaskHandle landscapeTask, nameTask, faceTask, collisionTask;
+    std::vector<TaskHandle> meshTasks;
+    // ȡģ͵ȫɺģͲܻȫֱ
+    std::vector<TaskHandle> landscapeUsers, nameUsers, faceUsers;
+    std::vector<Voxel> landscape;
+    std::vector<VoxelName> name;
+    FaceParts face;
+    VoxelQuery collision;
+    std::vector<CollisionPart> collisionParts;
+    bool landscapeReady = false, nameReady = false, faceReady = false, collisionReady = false;
+    std::string meshReports[4];     // ۡԻֱͳƣɺӡ
+};
+std::unique_ptr<ModelLoad> g_load;
+double g_startMs = -1.0;                            // main() ʼʱ䣬ͳƵ
+const size_t UPLOAD_BUDGET_BYTES = 256 * 1024;      // ÿ֡ϴĶ
+
+// ȫģɡ񹹽޳ȹã
+// ʵȫֱ֮˳ʱȵȹ߳̽ͷģͺͼ״̬
+std::unique_ptr<JobSystem> g_jobs;
+
+// ͳƸǲ㣨 'h' أ
+bool g_showHud = false;
+
+// ֱ̬ʣ 'v' أ--frame-target ms Ŀ꣬0 ʾرգ
+DynamicResolution g_dynamicResolution;
 
 // ---  ---
 void init();
+void startModelLoad();
+void queueGpuMeshes();
+bool finishModelLoad(bool block);
+void warmNameGlyphs(const NameDesc& desc);
+void setNameText(const NameDesc& desc);
+void updateMemoryStats();
+void buildCollisionWorld(VoxelQuery& world, std::vector<CollisionPart>& parts, const std::vector<Voxel>& landscape,
+    const std::vector<VoxelName>& name, const FaceParts& face, const float figurePosition[3]);
+void startSceneReload();
+void runSceneReload(SceneReload& reload);
+void applySceneReload();
+void buildSceneGraph();
+void loadNodeMatrix(int node);
 void display();
+void tick(float time);
+void drawCrowdImmediate(float time);
 void reshape(int w, int h);
 void timer(int value);
 void keyboard(unsigned char key, int x, int y);
+void keyboardUp(unsigned char key, int x, int y);
+void windowEntry(int state);
+void windowStatus(int state);
+void mouse(int button, int state, int x, int y);
+float nameOffsetAt(float time);
+double nowMs();
+LightBake sceneLightBake();
 
 // ---  ---
 int main(int argc, char** argv) {
+    g_startMs = nowMs();
+
+    // ׼ģʽֱcrowd  regression Լ򿪴ڣ
+    if (argc > 2 && strcmp(argv[1], "--bench") == 0) {
+        return runBenchmark(argv[2], argc - 3, argv + 3);
+    }
+    // Ⱦģʽû GPU ĻãڣֱͼƬ
+    if (argc > 2 && strcmp(argv[1], "--cpu-render") == 0) {
+        return runCpuRender(argc - 2, argv + 2);
+    }
+
+    // Ⱥģʽ--crowd N
+    if (argc > 2 && strcmp(argv[1], "--crowd") == 0) {
+        g_crowd.resize(atoi(argv[2]));
+        printf("crowd mode: %d figures\n", g_crowd.size());
+    }
+    // ļ--scene pathĬǵǰĿ¼µ scene.txt
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (strcmp(argv[i], "--scene") == 0) g_scenePath = argv[i + 1];
+        if (strcmp(argv[i], "--frame-target") == 0) {
+            float ms = (float)atof(argv[i + 1]);
+            if (ms > 0.0f) g_dynamicResolution.setTargetMs(ms);
+            else g_dynamicResolution.setEnabled(false);
+        }
+    }
+
+    g_jobs.reset(new JobSystem());
+
     glutInit(&argc, argv);
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
     glutInitWindowSize(1280, 720);
@@ -37,6 +198,11 @@ int main(int argc, char** argv) {
 
     // [] ע¼
     glutKeyboardFunc(keyboard);
+    glutKeyboardUpFunc(keyboardUp);
+    glutIgnoreKeyRepeat(1); // סļ InputState ٣Ҫϵͳظ¼
+    glutEntryFunc(windowEntry); // 뿪 / ʧȥʱղ̧¼סļ
+    glutWindowStatusFunc(windowStatus);
+    glutMouseFunc(mouse); // ѡ
 
     glutTimerFunc(0, timer, 0); // ѭ
 
@@ -46,7 +212,7 @@ int main(int argc, char** argv) {
 
 // --- ʼ ---
 void init() {
-    glClearColor(0.5f, 0.7f, 1.0f, 1.0f); // ɫ
+    glClearColor(SKY_COLOR[0], SKY_COLOR[1], SKY_COLOR[2], SKY_COLOR[3]); // ɫ
     glEnable(GL_DEPTH_TEST); // Ȳԣȷڵϵ
 
     // --- ĹպͲ (Stretch Feature) ---
@@ -57,132 +223,853 @@ void init() {
     glEnable(GL_FOG); // Ч
     {
         // ɫΪɫ뱳ں
-        GLfloat fogColor[] = { 0.5f, 0.7f, 1.0f, 1.0f };
-        glFogfv(GL_FOG_COLOR, fogColor);
+        glFogfv(GL_FOG_COLOR, SKY_COLOR);
 
         // ģʽEXP2 (ָƽ) ȽȻԽԶԽŨ
         glFogi(GL_FOG_MODE, GL_EXP2);
 
         // ܶȣ0.015 һȽֵܿˣģԶɽ
         // ̫ŨСһ ( 0.01)̫Ĵһ ( 0.02)
-        glFogf(GL_FOG_DENSITY, 0.015f);
+        glFogf(GL_FOG_DENSITY, FOG_DENSITY);
 
         // ʾЧðѱɫ (glClearColor) ҲΪͬɫ
-        glClearColor(0.5f, 0.7f, 1.0f, 1.0f);
+        glClearColor(SKY_COLOR[0], SKY_COLOR[1], SKY_COLOR[2], SKY_COLOR[3]);
     }
 
-    // ùԴ
-    GLfloat light_ambient[] = { 0.3f, 0.3f, 0.3f, 1.0f }; // ⣬ðȫ
-    GLfloat light_diffuse[] = { 1.0f, 1.0f, 1.0f, 1.0f }; // ⣬Դ
-    GLfloat light_specular[] = { 1.0f, 1.0f, 1.0f, 1.0f }; // 淴⣬߹
-    GLfloat light_position[] = { 10.0f, 10.0f, 10.0f, 0.0f }; // Դλã⣩
-
-    glLightfv(GL_LIGHT0, GL_AMBIENT, light_ambient);
-    glLightfv(GL_LIGHT0, GL_DIFFUSE, light_diffuse);
-    glLightfv(GL_LIGHT0, GL_SPECULAR, light_specular);
-    glLightfv(GL_LIGHT0, GL_POSITION, light_position);
+    // ùԴԣ SceneParams.h
+    glLightfv(GL_LIGHT0, GL_AMBIENT, LIGHT_AMBIENT);
+    glLightfv(GL_LIGHT0, GL_DIFFUSE, LIGHT_DIFFUSE);
+    glLightfv(GL_LIGHT0, GL_SPECULAR, LIGHT_SPECULAR);
+    glLightfv(GL_LIGHT0, GL_POSITION, LIGHT_POSITION);
 
     // ɫ׷ٲʣglColorȻӰɫܹӰ
     glEnable(GL_COLOR_MATERIAL);
     glColorMaterial(GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
 
     // òʵľ淴ԣһ߹
-    GLfloat mat_specular[] = { 0.5f, 0.5f, 0.5f, 1.0f };
-    GLfloat mat_shininess[] = { 50.0 };
-    glMaterialfv(GL_FRONT, GL_SPECULAR, mat_specular);
-    glMaterialfv(GL_FRONT, GL_SHININESS, mat_shininess);
+    glMaterialfv(GL_FRONT, GL_SPECULAR, MAT_SPECULAR);
+    glMaterialf(GL_FRONT, GL_SHININESS, MAT_SHININESS);
+
+    if (g_startMs < 0.0) g_startMs = nowMs();
+    startModelLoad();
+    buildSceneGraph();
+    if (g_crowd.size() == 0) g_crowd.resize(1);
 
-    // ģ
-    selfPortraitModel = createSelfPortraitModel();
-    watchModel = createWatchModel(); // ֱģ
-    nameModel = createDetailedNameModel();
-    landscapeModel = createLandscapeModel();
+    // ɫչʱ˻ drawCube ·
+    if (g_voxelRenderer.init()) {
+        queueGpuMeshes();
+    } else {
+        printf("packed vertex path unavailable, using immediate mode\n");
+        g_renderPath = RENDER_PATH_IMMEDIATE;
+    }
+    // û֡ʱһֱڷֱʻ
+    if (!g_dynamicResolution.init()) printf("dynamic resolution unavailable, rendering at window size\n");
+
+    // ڼ޸ɺٴ
+    g_sceneWatcher.watch(g_scenePath);
+}
+
+// ģݲȴɣ漰 GLȾģʽͻ׼Եã
+void loadModels() {
+    startModelLoad();
+    finishModelLoad(true);
+}
+
+// ύģɺײ
+void startModelLoad() {
+    // ԻֱڱѾɺãֻȡָ
+    selfPortraitModel = bakedSelfPortraitModel();
+    watchModel = bakedWatchModel(); // ֱģ
+
+    // ļȱʧдʱõĬϳ
+    std::string error;
+    if (!loadSceneFile(g_scenePath, g_sceneDesc, error)) {
+        printf("%s, using the built-in scene\n", error.c_str());
+    }
+
+    g_load.reset(new ModelLoad());
+    ModelLoad* load = g_load.get();
+    // ۰в
+    load->landscapeTask = g_jobs->submit([load]() { load->landscape = createLandscapeModel(g_sceneDesc.landscape, g_jobs.get()); });
+    load->nameTask = g_jobs->submit([load]() { load->name = createDetailedNameModel(g_sceneDesc.name); });
+    load->faceTask = g_jobs->submit([load]() { load->face = createFaceParts(); });
+    // ײģɺ GPU Ĵͬʱ
+    load->collisionTask = g_jobs->submit([load]() {
+        buildCollisionWorld(load->collision, load->collisionParts, load->landscape, load->name, load->face,
+            g_sceneDesc.figurePosition);
+    }, { load->landscapeTask, load->nameTask, load->faceTask });
+
+    load->landscapeUsers = { load->landscapeTask, load->collisionTask };
+    load->nameUsers = { load->nameTask, load->collisionTask };
+    load->faceUsers = { load->faceTask, load->collisionTask };
+}
+
+static std::string meshReport(const char* name, const VoxelMeshData& m) {
+    char line[256];
+    snprintf(line, sizeof(line), "%-9s %6d voxels, %3zu chunks, %6.1f KB packed (float path %7.1f KB), %d on float fallback, max error %g",
+        name, m.voxelCount(), m.chunks.size(), m.vertexBytes() / 1024.0,
+        m.voxelCount() * FLOAT_CUBE_BYTES / 1024.0, m.looseVoxels, m.maxError);
+    std::string report = line;
+    if (m.approximatedColors > 0) {
+        snprintf(line, sizeof(line), ", %d colors approximated", m.approximatedColors);
+        report += line;
+    }
+    return report;
+}
+
+// ɫԺɫӳ䵽ӽɫıɫµĽƾʹӡ
+static int g_warnedApproximations = 0;
+
+static void warnPaletteApproximations() {
+    int approximated = g_voxelRenderer.palette().approximated();
+    if (approximated <= g_warnedApproximations) return;
+    printf("warning: palette is full (%d colors); %d colors were drawn with the nearest existing color\n",
+        Palette::MAX_COLORS, approximated);
+    g_warnedApproximations = approximated;
+}
+
+// ̬ģڹ߳пŽȾϴУˮֻϴֹ񣬲ɫ
+// ֻԼģͣۻûʱͿԿʼϴ
+void queueGpuMeshes() {
+    ModelLoad* load = g_load.get();
+    // ۺֲתҲպ AO 決ɫж𶥵
+    const LightBake bake = sceneLightBake();
+
+    int landscapeMesh = g_landscapeMesh = g_voxelRenderer.createMesh(true);
+    for (int i = 0; i < FIGURE_PARTS; ++i) g_figureMeshes[i] = g_voxelRenderer.createMesh(false);
+    const int* figure = g_figureMeshes;
+
+    TaskHandle landscapeTask = g_jobs->submit([load, bake, landscapeMesh]() {
+        VoxelMeshData mesh = buildVoxelMesh(load->landscape.data(), load->landscape.size(), 1.0f,
+            g_voxelRenderer.palette(), 0, &bake);
+        load->meshReports[0] = meshReport("landscape", mesh);
+        g_voxelRenderer.queueMesh(landscapeMesh, std::move(mesh));
+    }, { load->landscapeTask });
+    TaskHandle portraitTask = g_jobs->submit([load, figure]() {
+        VoxelMeshData mesh = buildVoxelMesh(selfPortraitModel.data(), selfPortraitModel.size(), 1.0f, g_voxelRenderer.palette());
+        load->meshReports[1] = meshReport("portrait", mesh);
+        g_voxelRenderer.queueMesh(figure[0], std::move(mesh));
+    });
+    TaskHandle watchTask = g_jobs->submit([load, figure]() {
+        VoxelMeshData mesh = buildVoxelMesh(watchModel.data(), watchModel.size(), 0.2f, g_voxelRenderer.palette());
+        load->meshReports[2] = meshReport("watch", mesh);
+        g_voxelRenderer.queueMesh(figure[1], std::move(mesh));
+    });
+    // üë϶ǣȺɫÿ˵ʱλƶ
+    TaskHandle faceTask = g_jobs->submit([load, figure]() {
+        Palette& palette = g_voxelRenderer.palette();
+        const FaceParts& fp = load->face;
+        VoxelMeshData face = buildVoxelMesh(fp.rest.data(), fp.rest.size(), 0.25f, palette);
+        load->meshReports[3] = meshReport("face", face);
+        g_voxelRenderer.queueMesh(figure[2], std::move(face));
+        g_voxelRenderer.queueMesh(figure[3], buildVoxelMesh(fp.brows.data(), fp.brows.size(), 0.25f, palette, VERTEX_TAG_BROW));
+        g_voxelRenderer.queueMesh(figure[4], buildVoxelMesh(fp.glint.data(), fp.glint.size(), 0.25f, palette, VERTEX_TAG_GLINT));
+    }, { load->faceTask });
+    // ֵɫŲ 256 ɫɫ壺ÿһΣɫɫ
+    TaskHandle nameTask = g_jobs->submit([]() { warmNameGlyphs(g_sceneDesc.name); }, { load->nameTask });
+
+    load->meshTasks = { landscapeTask, portraitTask, watchTask, faceTask, nameTask };
+    load->landscapeUsers.push_back(landscapeTask);
+    load->nameUsers.push_back(nameTask);
+    load->faceUsers.push_back(faceTask);
+
+    // ˮʵֻм KBֱϴ
+    std::vector<PackedInstance> water;
+    std::vector<Voxel> surface = createWaterSurface();
+    buildInstances(surface.data(), surface.size(), 0.5f, INSTANCE_WATER, g_voxelRenderer.palette(), water);
+    g_waterInstances = g_voxelRenderer.addInstances(water, 0.5f, 1.0f);
+}
+
+// ̣߳Ѿɵģͻȫֱblock Ϊ true ʱȵɡϴ
+// ģ͡ײ GPU ȫʱ true
+bool finishModelLoad(bool block) {
+    ModelLoad* load = g_load.get();
+    if (!load) return true;
+
+    std::vector<TaskHandle> tasks = { load->landscapeTask, load->nameTask, load->faceTask, load->collisionTask };
+    tasks.insert(tasks.end(), load->meshTasks.begin(), load->meshTasks.end());
+    if (block) {
+        g_jobs->waitAll(tasks);
+    } else if (g_jobs->threadCount() == 1) {
+        // ̵߳ûй̣߳ÿִ֡һ
+        g_jobs->runOne();
+    }
+
+    auto finished = [](const std::vector<TaskHandle>& list) {
+        for (const auto& t : list) {
+            if (!t->done) return false;
+        }
+        return true;
+    };
+    if (!load->landscapeReady && finished(load->landscapeUsers)) {
+        landscapeModel.swap(load->landscape);
+        load->landscapeReady = true;
+    }
+    if (!load->nameReady && finished(load->nameUsers)) {
+        nameModel.swap(load->name);
+        if (g_voxelRenderer.ready()) setNameText(g_sceneDesc.name);
+        load->nameReady = true;
+    }
+    if (!load->faceReady && finished(load->faceUsers)) {
+        g_faceParts = std::move(load->face);
+        load->faceReady = true;
+    }
+    if (!load->collisionReady && load->collisionTask->done) {
+        g_collision = std::move(load->collision);
+        g_collisionParts.swap(load->collisionParts);
+        g_camera.setCollider(&g_collision);
+        load->collisionReady = true;
+    }
+    // ֵģͻ֮ŷŽϴУն
+    while (block && g_voxelRenderer.uploadsPending()) {
+        g_voxelRenderer.processUploads(UPLOAD_BUDGET_BYTES);
+        glFlush(); // ݴ滷դܹ
+    }
+    if (!finished(tasks) || g_voxelRenderer.uploadsPending()) return false;
+
+    for (const auto& line : load->meshReports) {
+        if (!line.empty()) printf("%s\n", line.c_str());
+    }
+    if (g_voxelRenderer.ready()) {
+        printf("palette %d colors (%d approximated), GPU buffers %.1f KB\n", g_voxelRenderer.palette().size(),
+            g_voxelRenderer.palette().approximated(), g_voxelRenderer.gpuBytes() / 1024.0);
+        warnPaletteApproximations();
+    }
+    g_load.reset();
+    return true;
+}
+
+// ̣߳õ񻯣VoxelFont ߳ϴʱֱȡ
+void warmNameGlyphs(const NameDesc& desc) {
+    const LightBake bake = sceneLightBake();
+    for (const NameLetter& letter : desc.letters) voxelGlyphMesh(letter.ch, bake);
+}
+
+// ̣߳³ֵηŽϴУٻµĸʵѾϴβ
+void setNameText(const NameDesc& desc) {
+    const LightBake bake = sceneLightBake();
+    std::vector<GlyphInstance> letters;
+    for (const NameLetter& letter : desc.letters) {
+        const VoxelGlyph* glyph = voxelGlyph(letter.ch);
+        if (!glyph) continue;
+        auto it = g_glyphHandles.find(letter.ch);
+        if (it == g_glyphHandles.end()) {
+            int handle = g_voxelRenderer.createGlyph();
+            g_voxelRenderer.queueGlyph(handle, voxelGlyphMesh(letter.ch, bake), (int)glyph->voxels.size());
+            it = g_glyphHandles.insert({ letter.ch, handle }).first;
+        }
+        letters.push_back({ it->second, letter.x, letter.r, letter.g, letter.b });
+    }
+    g_voxelRenderer.setGlyphText(letters, desc.z);
+}
+
+// Ѿֹʱ̵ĳŽײѯṹֵƫ renderScene() ͬ
+// ģɲȼʱڹ߳ģͽһݣ廻
+void buildCollisionWorld(VoxelQuery& world, std::vector<CollisionPart>& parts, const std::vector<Voxel>& landscape,
+    const std::vector<VoxelName>& name, const FaceParts& face, const float figurePosition[3]) {
+    world.clear();
+    parts.clear();
+    // build() ֮ǰ boxCount()  0Լ
+    int added = 0;
+    auto add = [&world, &added](float x, float y, float z, float size, float r, float g, float b) {
+        world.addVoxel(x, y, z, size, r, g, b);
+        ++added;
+    };
+
+    parts.push_back({ "landscape", added });
+    for (const auto& v : landscape) add(v.x, v.y, v.z, 1.0f, v.r, v.g, v.b);
+    parts.push_back({ "water", added });
+    for (const auto& v : createWaterSurface()) add(v.x, v.y, v.z, 1.0f, v.r, v.g, v.b);
+
+    world.setOffset(figurePosition[0], figurePosition[1], figurePosition[2]);
+    parts.push_back({ "portrait", added });
+    for (const auto& v : selfPortraitModel) add(v.x, v.y, v.z, 1.0f, v.r, v.g, v.b);
+    parts.push_back({ "watch", added });
+    for (const auto& v : watchModel) add(v.x, v.y, v.z, 0.2f, v.r, v.g, v.b);
+    parts.push_back({ "face", added });
+    for (const auto& v : face.rest) add(v.x, v.y, v.z, 0.25f, v.r, v.g, v.b);
+    for (const auto& v : face.brows) add(v.x, v.y, v.z, 0.25f, v.r, v.g, v.b);
+
+    world.setOffset(0.0f, 0.0f, 0.0f);
+    parts.push_back({ "name", added });
+    for (const auto& v : name) add(v.x, v.y, v.z, 0.25f, v.r, v.g, v.b);
+
+    world.build(1.0f);
+}
+
+// ļ棺ѽģɽ̣̼߳߳ɵĳ
+void startSceneReload() {
+    if (g_reload) {
+        g_reloadQueued = true;
+        return;
+    }
+    g_reload.reset(new SceneReload());
+    g_reload->desc = g_sceneDesc;
+    g_reload->startMs = nowMs();
+    SceneReload* reload = g_reload.get();
+    g_reload->task = g_jobs->submit([reload]() { runSceneReload(*reload); });
+}
+
+// ֻ̣߳ǰģͣȫд reload
+void runSceneReload(SceneReload& reload) {
+    double start = nowMs();
+    SceneDesc desc = reload.desc;
+    reload.ok = loadSceneFile(g_scenePath, desc, reload.error);
+    if (!reload.ok) return;
+
+    reload.landscapeChanged = desc.landscape != g_sceneDesc.landscape;
+    reload.nameChanged = desc.name != g_sceneDesc.name;
+    reload.figureMoved = !std::equal(desc.figurePosition, desc.figurePosition + 3, g_sceneDesc.figurePosition);
+    reload.desc = desc;
+
+    if (reload.landscapeChanged) {
+        reload.landscape = createLandscapeModel(desc.landscape, g_jobs.get());
+        reload.dirtyChunks = diffMeshChunks(landscapeModel, reload.landscape, 1.0f);
+        if (g_voxelRenderer.ready()) {
+            const LightBake bake = sceneLightBake();
+            reload.rebuiltChunks = buildVoxelMeshChunks(reload.landscape.data(), reload.landscape.size(), 1.0f,
+                g_voxelRenderer.palette(), reload.dirtyChunks, 0, &bake);
+        }
+    }
+    if (reload.nameChanged) {
+        reload.name = createDetailedNameModel(desc.name);
+        warmNameGlyphs(desc.name);
+    }
+    if (reload.landscapeChanged || reload.nameChanged || reload.figureMoved) {
+        buildCollisionWorld(reload.collision, reload.collisionParts,
+            reload.landscapeChanged ? reload.landscape : landscapeModel,
+            reload.nameChanged ? reload.name : nameModel, g_faceParts, desc.figurePosition);
+    }
+    reload.workerMs = nowMs() - start;
+}
+
+// ̣߳߳ɺģֻͣϴؽ
+void applySceneReload() {
+    if (!g_reload) return;
+    // ̵߳ûйֻ̣߳ wait() ִ
+    if (g_jobs->threadCount() == 1) g_jobs->wait(g_reload->task);
+    if (!g_reload->task->done) return;
+
+    std::unique_ptr<SceneReload> reload(std::move(g_reload));
+    if (!reload->ok) {
+        printf("scene reload failed: %s (keeping the current scene)\n", reload->error.c_str());
+    } else if (!reload->landscapeChanged && !reload->nameChanged && !reload->figureMoved) {
+        printf("scene reload: %s unchanged\n", g_scenePath);
+    } else {
+        double uploadStart = nowMs();
+        int uploaded = 0;
+        if (reload->landscapeChanged) {
+            landscapeModel.swap(reload->landscape);
+            if (g_landscapeMesh >= 0) uploaded = g_voxelRenderer.updateMesh(g_landscapeMesh, reload->rebuiltChunks, reload->dirtyChunks);
+            warnPaletteApproximations();
+        }
+        if (reload->nameChanged) {
+            nameModel.swap(reload->name);
+            if (g_voxelRenderer.ready()) setNameText(reload->desc.name);
+        }
+        const float* p = reload->desc.figurePosition;
+        g_scene.setTranslation(g_nodes.figure, p[0], p[1], p[2]);
+        g_collision = std::move(reload->collision);
+        g_collisionParts.swap(reload->collisionParts);
+        g_sceneDesc = reload->desc;
+
+        printf("scene reload:%s%s%s %zu dirty chunks, %d re-uploaded; worker %.1f ms, apply %.1f ms, total %.1f ms\n",
+            reload->landscapeChanged ? " landscape" : "", reload->nameChanged ? " name" : "",
+            reload->figureMoved ? " figure" : "", reload->dirtyChunks.size(), uploaded,
+            reload->workerMs, nowMs() - uploadStart, nowMs() - reload->startMs);
+    }
+
+    if (g_reloadQueued) {
+        g_reloadQueued = false;
+        startSceneReload();
+    }
 }
 
 void display() {
+    double frameStart = nowMs();
+    // ȡʱ
+    float time = glutGet(GLUT_ELAPSED_TIME) / 1000.0f;
+
+    tick(time);
+    // ֱֻ̬ͽʱ䣺ϴͳƺ HUD ĺʱȾֱ޹
+    double sceneStart = nowMs();
+    g_dynamicResolution.beginScene();
+    renderScene(time);
+    g_dynamicResolution.presentScene();
+    double sceneMs = nowMs() - sceneStart;
+    g_frameStats.renderScale = g_dynamicResolution.scale();
+    g_frameStats.renderWidth = g_dynamicResolution.renderWidth();
+    g_frameStats.renderHeight = g_dynamicResolution.renderHeight();
+    g_frameStats.controlMs = g_dynamicResolution.frameMs();
+    g_frameStats.targetMs = g_dynamicResolution.ready() && g_dynamicResolution.enabled() ? g_dynamicResolution.target() : 0.0f;
+    updateMemoryStats();
+    if (g_showHud) drawStatsHud(renderPathName(g_renderPath));
+    // أԼȼ³ֵΣÿ֡ϴһ֣һ֡ͻử
+    size_t uploaded = 0;
+    if (g_voxelRenderer.ready() && g_voxelRenderer.uploadsPending()) {
+        uploaded = g_voxelRenderer.processUploads(UPLOAD_BUDGET_BYTES);
+        if (g_load) g_startupStats.uploadedBytes += uploaded;
+    }
+    double swapStart = nowMs();
+    glutSwapBuffers();
+    double swapMs = nowMs() - swapStart;
+    double renderMs = nowMs() - frameStart;
+    endFrameStats(renderMs);
+    // ϴ֡ʱҪݣΪ
+    if (uploaded == 0) g_dynamicResolution.update(sceneMs + swapMs);
+
+    if (g_startupStats.firstFrameMs < 0.0) g_startupStats.firstFrameMs = nowMs() - g_startMs;
+    if (g_load) g_startupStats.framesWhileLoading++;
+
+    // һ֡õµİ GPU ټʱõ뵽ӳ
+    if (g_pendingInputMs >= 0.0) {
+        glFinish();
+        recordInputLatency(nowMs() - g_pendingInputMs);
+        g_pendingInputMs = -1.0;
+    }
+}
+
+// ÿ֡ģ⣺һμ̣֡ƶ¶
+void tick(float time) {
+    float dt = g_lastTickTime < 0.0f ? 0.0f : std::min(std::max(time - g_lastTickTime, 0.0f), MAX_TICK_DELTA);
+    g_lastTickTime = time;
+
+    double eventMs;
+    if (g_input.sample(eventMs) && g_pendingInputMs < 0.0) g_pendingInputMs = eventMs;
+
+    // λãԶ˾ƶ
+    g_camera.update(time);
+    g_camera.updateMovement(g_input, dt);
+
+    // ָֻֽڵƽƣ renderScene ﰴ㣩
+    g_scene.setTranslation(g_nodes.name, 0.0f, nameOffsetAt(time), 0.0f);
+
+    // أѾɵģͣ display() һ֡ϴ
+    if (g_load) {
+        if (finishModelLoad(false)) {
+            g_startupStats.loadedMs = nowMs() - g_startMs;
+            printf("startup\n");
+            printStartupStats();
+        }
+        return;
+    }
+
+    // ļȼ
+    if (g_sceneWatcher.poll()) startSceneReload();
+    applySceneReload();
+}
+
+// ͼĽṹ renderScene() Ļ˳ӦȺʵͲڵ
+void buildSceneGraph() {
+    g_scene = SceneGraph();
+    g_nodes.landscape = g_scene.addNode("landscape");
+    g_nodes.water = g_scene.addNode("water");
+    g_nodes.figure = g_scene.addNode("figure");
+    g_nodes.watch = g_scene.addNode("watch", g_nodes.figure);
+    g_nodes.face = g_scene.addNode("face", g_nodes.figure);
+    g_nodes.name = g_scene.addNode("name");
+
+    const float* p = g_sceneDesc.figurePosition;
+    g_scene.setTranslation(g_nodes.figure, p[0], p[1], p[2]);
+    g_scene.update();
+}
+
+//  ͼ * ڵ Ϊģͼϴÿڵÿ֡һΣ
+void loadNodeMatrix(int node) {
+    float m[16];
+    SceneGraph::multiply(g_viewMatrix, g_scene.world(node), m);
+    glLoadMatrixf(m);
+    g_frameStats.matrixUploads++;
+}
+
+//  time ʱ̵һ֡׼ֱӵã
+void renderScene(float time) {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glLoadIdentity();
+    bool packed = g_renderPath == RENDER_PATH_PACKED;
 
+    // Դʱģͼ任ͼ֮ãԴ̶
+    // ·決̬ģ͵ķsceneLightBakeһ£·Ĺͬ
     g_camera.applyView();
+    glLightfv(GL_LIGHT0, GL_POSITION, LIGHT_POSITION);
+    glGetFloatv(GL_MODELVIEW_MATRIX, g_viewMatrix);
 
-    // ȡʱ
-    float time = glutGet(GLUT_ELAPSED_TIME) / 1000.0f;
+    resetFrameStats();
+    g_frameStats.nodesUpdated = g_scene.update();
 
     // 1. ƾ̬
-    for (const auto& voxel : landscapeModel) {
-        drawCube(voxel.x, voxel.y, voxel.z, 1.0f, voxel.r, voxel.g, voxel.b);
+    loadNodeMatrix(g_nodes.landscape);
+    if (packed) {
+        g_voxelRenderer.drawMesh(g_landscapeMesh, g_jobs.get());
+    } else {
+        for (const auto& voxel : landscapeModel) {
+            drawCube(voxel.x, voxel.y, voxel.z, 1.0f, voxel.r, voxel.g, voxel.b);
+        }
     }
 
     // 2. ƶ̬ˮ
-    drawAnimatedWater(time);
+    loadNodeMatrix(g_nodes.water);
+    if (packed) {
+        g_voxelRenderer.drawInstances(g_waterInstances, time);
+    } else {
+        drawAnimatedWater(time);
+    }
 
-    // []  ѩЧ
+    // []  ѩЧ꣩
+    glLoadMatrixf(g_viewMatrix);
     drawSnow(time);
 
-    // ---  ---
-    glPushMatrix();
-    glTranslatef(-1.5f, 0.0f, -2.0f);
-
-    // ***  3:  (Breathing) ***
-    //  Y ᷽΢С (1.0 ~ 1.02)
-    // ģǳϸ
-    float breathScale = 1.0f + sin(time * 2.0f) * 0.01f;
-    glScalef(1.0f, breathScale, 1.0f);
+    // --- 3. Ի ()4. ֱ5. ϸ ---
+    //  CPU ϰ׶޳ֻѿü˽ GPU  drawCube
+    // üƽȡڵģͼֱʵڵĿռ
+    loadNodeMatrix(g_nodes.figure);
+    float planes[6][4];
+    currentFrustumPlanes(planes);
+    int visible = g_crowd.cull(planes, g_jobs.get());
+    long long figureVoxels = (long long)selfPortraitModel.size() + watchModel.size() +
+        g_faceParts.rest.size() + g_faceParts.brows.size() + g_faceParts.glint.size();
+    g_frameStats.voxelsCulled += (g_crowd.size() - visible) * figureVoxels;
 
-    // 3. Ի ()
-    for (const auto& voxel : selfPortraitModel) {
-        drawCube(voxel.x, voxel.y, voxel.z, 1.0f, voxel.r, voxel.g, voxel.b);
+    if (packed) {
+        // ڵ㱾ֱøԽڵľֲ
+        const float* parts[FIGURE_PARTS] = {
+            SceneGraph::identity(),
+            g_scene.local(g_nodes.watch),
+            g_scene.local(g_nodes.face), g_scene.local(g_nodes.face), g_scene.local(g_nodes.face)
+        };
+        g_voxelRenderer.drawCrowd(g_figureMeshes, parts, FIGURE_PARTS, g_crowd.visibleInstances().data(), visible, time);
+    } else {
+        drawCrowdImmediate(time);
     }
-    // 4. ֱ
-    for (const auto& watch : watchModel) {
-        drawCube(watch.x, watch.y, watch.z, 0.2f, watch.r, watch.g, watch.b);
+
+    // 6. 
+    loadNodeMatrix(g_nodes.name);
+    if (packed) {
+        g_voxelRenderer.drawGlyphs();
+    } else {
+        for (const auto& voxel : nameModel) {
+            drawCube(voxel.x, voxel.y, voxel.z, 0.25f, voxel.r, voxel.g, voxel.b);
+        }
     }
+}
 
-    // *** ؼ޸ģÿһ֡ʵʱϸ ***
-    //  timeȡǰһ֡üëӦڵλ
-    std::vector<VoxelFace> currentFace = createFaceDetails(time);
+// drawCube ·Ⱥ״̬ںһã
+void drawCrowdImmediate(float time) {
+    g_crowd.animate(time, g_jobs.get());
+    const std::vector<CrowdInstance>& instances = g_crowd.visibleInstances();
+    const std::vector<CrowdPose>& poses = g_crowd.poses();
 
-    // 5. ϸ (ɵ currentFace)
-    for (const auto& f : currentFace) {
-        drawCube(f.x, f.y, f.z, 0.25f, f.r, f.g, f.b);
-    }
-    glPopMatrix();
+    // ͼ * ڵ㣬ֻ֡һ
+    float figureView[16];
+    SceneGraph::multiply(g_viewMatrix, g_scene.world(g_nodes.figure), figureView);
 
-    // 6. 
-    glPushMatrix();
-    glTranslatef(0.0f, g_nameYOffset, 0.0f);
-    for (const auto& voxel : nameModel) {
-        drawCube(voxel.x, voxel.y, voxel.z, 0.25f, voxel.r, voxel.g, voxel.b);
-    }
-    glPopMatrix();
+    for (size_t i = 0; i < instances.size(); ++i) {
+        const CrowdInstance& inst = instances[i];
+        const CrowdPose& pose = poses[i];
 
-    glutSwapBuffers();
+        // ʵ任 = ƽ * ת * ţÿϴһξ
+        // ***  3:  (Breathing) ***
+        //  Y ᷽΢С (1.0 ~ 1.02)
+        const float translation[3] = { inst.x, 0.0f, inst.z };
+        const float scale[3] = { 1.0f, pose.breathScale, 1.0f };
+        float instanceView[16], partView[16];
+        SceneGraph::composeTRS(translation, inst.yaw, scale, instanceView);
+        SceneGraph::multiply(figureView, instanceView, instanceView);
+
+        glLoadMatrixf(instanceView);
+        g_frameStats.matrixUploads++;
+        for (const auto& voxel : selfPortraitModel) {
+            drawCube(voxel.x, voxel.y, voxel.z, 1.0f, voxel.r, voxel.g, voxel.b);
+        }
+
+        SceneGraph::multiply(instanceView, g_scene.local(g_nodes.watch), partView);
+        glLoadMatrixf(partView);
+        g_frameStats.matrixUploads++;
+        for (const auto& watch : watchModel) {
+            drawCube(watch.x, watch.y, watch.z, 0.2f, watch.r, watch.g, watch.b);
+        }
+
+        // ϸڣüëⰴ˵Ķ״̬ƶ
+        SceneGraph::multiply(instanceView, g_scene.local(g_nodes.face), partView);
+        glLoadMatrixf(partView);
+        g_frameStats.matrixUploads++;
+        for (const auto& f : g_faceParts.rest) {
+            drawCube(f.x, f.y, f.z, 0.25f, f.r, f.g, f.b);
+        }
+        if (pose.glintVisible) {
+            for (const auto& f : g_faceParts.glint) {
+                drawCube(f.x + pose.glintX, f.y, f.z, 0.25f, f.r, f.g, f.b);
+            }
+        }
+        for (const auto& f : g_faceParts.brows) {
+            drawCube(f.x, f.y + pose.browOffset, f.z, 0.25f, f.r, f.g, f.b);
+        }
+    }
 }
-// ̻ص
+
+// ̻صһԲﴦƶֻ¼״̬
 void keyboard(unsigned char key, int x, int y) {
+    g_input.keyDown(key, nowMs());
+
+    if (key == 'p' || key == 'P') {
+        // л·㲻ʱ drawCube
+        if (g_voxelRenderer.ready()) {
+            g_renderPath = g_renderPath == RENDER_PATH_PACKED ? RENDER_PATH_IMMEDIATE : RENDER_PATH_PACKED;
+            printf("render path: %s\n", renderPathName(g_renderPath));
+        }
+    } else if (key == 'i' || key == 'I') {
+        printFrameStats(renderPathName(g_renderPath));
+    } else if (key == 'h' || key == 'H') {
+        g_showHud = !g_showHud;
+    } else if (key == 'v' || key == 'V') {
+        // ضֱ̬ʣرʱصڷֱʣ
+        if (g_dynamicResolution.ready()) {
+            g_dynamicResolution.setEnabled(!g_dynamicResolution.enabled());
+            printf("dynamic resolution: %s\n", g_dynamicResolution.enabled() ? "on" : "off");
+        }
+    }
+
     g_camera.handleKey(key);
     glutPostRedisplay(); // ػ棬֤Ӧ
 }
 
+void keyboardUp(unsigned char key, int x, int y) {
+    g_input.keyUp(key, nowMs());
+    glutPostRedisplay();
+}
+
+// 뿪ڣfreeglut  Windows ʧȥʱҲã̧֮¼ڣ
+// Ļסļһֱ㰴£ͣ
+void windowEntry(int state) {
+    if (state == GLUT_LEFT) g_input.releaseAll();
+}
+
+// ڱСȫסʱͬ
+void windowStatus(int state) {
+    if (state == GLUT_HIDDEN || state == GLUT_FULLY_COVERED) g_input.releaseAll();
+}
+
+// صʱ귽һߣӡе
+void mouse(int button, int state, int x, int y) {
+    if (button != GLUT_LEFT_BUTTON || state != GLUT_DOWN || g_collision.empty()) return;
+
+    GLdouble modelview[16], projection[16];
+    GLint viewport[4];
+    glPushMatrix();
+    glLoadIdentity();
+    g_camera.applyView();
+    glGetDoublev(GL_MODELVIEW_MATRIX, modelview);
+    glPopMatrix();
+    glGetDoublev(GL_PROJECTION_MATRIX, projection);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    // ԭϽǣGL ½
+    GLdouble winY = viewport[3] - y - 1;
+    GLdouble nearPoint[3], farPoint[3];
+    gluUnProject(x, winY, 0.0, modelview, projection, viewport, &nearPoint[0], &nearPoint[1], &nearPoint[2]);
+    gluUnProject(x, winY, 1.0, modelview, projection, viewport, &farPoint[0], &farPoint[1], &farPoint[2]);
+
+    float origin[3], dir[3];
+    float length = 0.0f;
+    for (int a = 0; a < 3; ++a) {
+        origin[a] = (float)nearPoint[a];
+        dir[a] = (float)(farPoint[a] - nearPoint[a]);
+        length += dir[a] * dir[a];
+    }
+    length = sqrt(length);
+    if (length <= 0.0f) return;
+    for (int a = 0; a < 3; ++a) dir[a] /= length;
+
+    VoxelHit hit;
+    if (!g_collision.raycast(origin, dir, length, hit)) {
+        printf("pick: nothing\n");
+        return;
+    }
+
+    const char* part = g_collisionParts.empty() ? "?" : g_collisionParts[0].name;
+    for (const auto& p : g_collisionParts) {
+        if (hit.box >= p.firstBox) part = p.name;
+    }
+    const VoxelBox& b = g_collision.box(hit.box);
+    printf("pick: %s voxel #%d at (%.2f, %.2f, %.2f), size %.2f, color (%.2f, %.2f, %.2f), distance %.2f, normal (%g, %g, %g)\n",
+        part, hit.box, (b.min[0] + b.max[0]) * 0.5f, (b.min[1] + b.max[1]) * 0.5f, (b.min[2] + b.max[2]) * 0.5f,
+        b.max[0] - b.min[0], b.r, b.g, b.b, hit.t, hit.normal[0], hit.normal[1], hit.normal[2]);
+}
+
 // --- ܺ ---
+// ͶӰֻ߱йأֱ̬ʱ䣻ӿ DynamicResolution ÿ֡úͻָ
 void reshape(int w, int h) {
+    g_dynamicResolution.resize(w, h);
     glViewport(0, 0, w, h);
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
-    gluPerspective(45.0, (double)w / (double)h, 1.0, 200.0);
+    gluPerspective(FIELD_OF_VIEW, (double)w / (double)h, NEAR_PLANE, FAR_PLANE);
     glMatrixMode(GL_MODELVIEW);
 }
 
 // --- ѭ ---
+// Ͷ display() ͷ tick() £ֻʱػ
 void timer(int value) {
-    float elapsedTime = glutGet(GLUT_ELAPSED_TIME) / 1000.0f; // ȡʱ䣨룩
+    glutPostRedisplay(); // ػ洰
+    glutTimerFunc(16, timer, 0); // Լ60 FPS
+}
 
-    // λ
-    g_camera.update(elapsedTime);
+// ¸ƫ
+float nameOffsetAt(float time) {
+    return sin(time * 2.0f) * 0.5f; // ٶȺͷ
+}
 
-    // ָ
-    g_nameYOffset = sin(elapsedTime * 2.0f) * 0.5f; // ٶȺͷ
+// ģ͵ǰռõڴ棨Ԫظֻ size / capacityÿ֡Ҳûп
+void updateMemoryStats() {
+    g_memoryStats.count = 0;
+    addMemoryEntry("landscape", (long long)(landscapeModel.capacity() * sizeof(Voxel)));
+    addMemoryEntry("portrait", (long long)(selfPortraitModel.size() * sizeof(Voxel)));
+    addMemoryEntry("watch", (long long)(watchModel.size() * sizeof(VoxelWatch)));
+    addMemoryEntry("face", (long long)((g_faceParts.rest.capacity() + g_faceParts.brows.capacity() +
+        g_faceParts.glint.capacity()) * sizeof(VoxelFace)));
+    addMemoryEntry("name", (long long)(nameModel.capacity() * sizeof(VoxelName)));
+    addMemoryEntry("glyphs", (long long)voxelFontBytes());
+    addMemoryEntry("collision", (long long)g_collision.voxelGrid().memoryBytes());
+    addMemoryEntry("crowd", (long long)g_crowd.memoryBytes());
+    g_memoryStats.gpuBytes = g_voxelRenderer.gpuBytes();
+}
 
-    glutPostRedisplay(); // ػ洰
-    glutTimerFunc(16, timer, 0); // Լ60 FPS
+// 決õĹղ init() Ĺ̶߹Դͬ꣩
+LightBake sceneLightBake() {
+    LightBake bake;
+    float length = std::sqrt(LIGHT_POSITION[0] * LIGHT_POSITION[0] + LIGHT_POSITION[1] * LIGHT_POSITION[1] +
+        LIGHT_POSITION[2] * LIGHT_POSITION[2]);
+    for (int a = 0; a < 3; ++a) bake.direction[a] = LIGHT_POSITION[a] / length;
+    bake.ambient = GLOBAL_AMBIENT + LIGHT_AMBIENT[0];
+    bake.diffuse = LIGHT_DIFFUSE[0];
+    return bake;
+}
+
+// ʱӣ룩ӳٲ
+double nowMs() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+// --- õĳӿڣSceneState.h ---
+JobSystem* createJobSystem(int threads) {
+    g_jobs.reset(threads > 0 ? new JobSystem(threads) : new JobSystem());
+    return g_jobs.get();
+}
+
+void setSceneTime(float time) {
+    g_camera.update(time);
+    // ͼ init() ｨڵûгͼ
+    if (g_scene.nodeCount() > 0) g_scene.setTranslation(g_nodes.name, 0.0f, nameOffsetAt(time), 0.0f);
+}
+
+const Camera& sceneCamera() {
+    return g_camera;
+}
+
+void openSceneWindow(const char* title, int width, int height) {
+    int argc = 1;
+    std::string name = title;
+    char* argv[] = { &name[0], nullptr };
+    glutInit(&argc, argv);
+    glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
+    glutInitWindowSize(width, height);
+    glutCreateWindow(title);
+
+    init();
+    finishModelLoad(true);
+    reshape(width, height);
+}
+
+RenderPath renderPath() {
+    return g_renderPath;
+}
+
+bool setRenderPath(RenderPath path) {
+    if (path == RENDER_PATH_PACKED && !g_voxelRenderer.ready()) return false;
+    g_renderPath = path;
+    return true;
+}
+
+Crowd& sceneCrowd() {
+    return g_crowd;
+}
+
+bool renderNameOnly(bool glyphs) {
+    if (nameModel.empty() || (glyphs && !g_voxelRenderer.ready())) return false;
+
+    // ֵİΧУǰȥռ 80%
+    float lo[3] = { nameModel[0].x, nameModel[0].y, nameModel[0].z };
+    float hi[3] = { lo[0], lo[1], lo[2] };
+    for (const auto& voxel : nameModel) {
+        const float p[3] = { voxel.x, voxel.y, voxel.z };
+        for (int a = 0; a < 3; ++a) {
+            lo[a] = std::min(lo[a], p[a]);
+            hi[a] = std::max(hi[a], p[a]);
+        }
+    }
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    float aspect = viewport[3] > 0 ? (float)viewport[2] / viewport[3] : 1.0f;
+    float tanHalf = std::tan(FIELD_OF_VIEW * 0.5f * 3.14159265f / 180.0f);
+    float halfWidth = (hi[0] - lo[0]) * 0.5f + 0.25f, halfHeight = (hi[1] - lo[1]) * 0.5f + 0.25f;
+    float distance = std::max(halfWidth / (tanHalf * aspect), halfHeight / tanHalf) / 0.8f;
+    float cx = (lo[0] + hi[0]) * 0.5f, cy = (lo[1] + hi[1]) * 0.5f;
+
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glLoadIdentity();
+    gluLookAt(cx, cy, hi[2] + distance, cx, cy, hi[2], 0.0, 1.0, 0.0);
+
+    // ӹպϾɫ
+    glPushAttrib(GL_ENABLE_BIT | GL_FOG_BIT);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_FOG);
+    glFogf(GL_FOG_DENSITY, 0.0f);   // ɫԼ gl_Fog 
+    if (glyphs) {
+        g_voxelRenderer.drawGlyphs(false);
+    } else {
+        for (const auto& voxel : nameModel) {
+            drawCube(voxel.x, voxel.y, voxel.z, 0.25f, voxel.r, voxel.g, voxel.b);
+        }
+    }
+    glPopAttrib();
+    return true;
+}
+
+const VoxelQuery& buildSceneCollision() {
+    buildCollisionWorld(g_collision, g_collisionParts, landscapeModel, nameModel, g_faceParts, g_sceneDesc.figurePosition);
+    return g_collision;
+}
+
+void buildCpuScene(SoftwareRenderer& renderer, float time) {
+    renderer.beginScene();
+
+    for (const auto& voxel : landscapeModel) {
+        renderer.addVoxel(voxel.x, voxel.y, voxel.z, 1.0f, voxel.r, voxel.g, voxel.b);
+    }
+    for (const auto& w : createWaterModel(time)) {
+        renderer.addVoxel(w.x, w.y, w.z, 1.0f, w.r, w.g, w.b);
+    }
+    for (const auto& p : createSnowParticles(time)) {
+        renderer.addPoint(p.x, p.y, p.z, p.r, p.g, p.b);
+    }
+
+    const float* p = g_sceneDesc.figurePosition;
+    renderer.setTransform(p[0], p[1], p[2], breathScaleAt(time));
+    for (const auto& voxel : selfPortraitModel) {
+        renderer.addVoxel(voxel.x, voxel.y, voxel.z, 1.0f, voxel.r, voxel.g, voxel.b);
+    }
+    for (const auto& watch : watchModel) {
+        renderer.addVoxel(watch.x, watch.y, watch.z, 0.2f, watch.r, watch.g, watch.b);
+    }
+    for (const auto& f : createFaceDetails(time)) {
+        renderer.addVoxel(f.x, f.y, f.z, 0.25f, f.r, f.g, f.b);
+    }
+
+    renderer.setTransform(0.0f, nameOffsetAt(time), 0.0f, 1.0f);
+    for (const auto& voxel : nameModel) {
+        renderer.addVoxel(voxel.x, voxel.y, voxel.z, 0.25f, voxel.r, voxel.g, voxel.b);
+    }
+
+    renderer.endScene();
 }
\ No newline at end of file